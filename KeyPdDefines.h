@@ -8,3 +8,30 @@
 #define C1 21
 #define C2 22
 #define C3 23//p1.23
+#define ROW_MASK ((1<<R0)|(1<<R1)|(1<<R2)|(1<<R3))
+
+//Keypad scan timing (Timer1 match interrupt period & debounce)
+#define KEY_SCAN_US        5000	//scan period in us
+#define KEY_DEBOUNCE_TICKS 4			//20ms stable before press/release
+#define KEY_REPEAT_DELAY   100		//500ms hold before first repeat
+#define KEY_REPEAT_RATE    40			//200ms between repeats
+#define KEY_SETTLE_US      2			//row drive to column sample (pull-up rise)
+
+//Per-key debounce states
+#define KEY_ST_IDLE        0
+#define KEY_ST_DEB_PRESS   1
+#define KEY_ST_PRESSED     2
+#define KEY_ST_REPEAT      3
+#define KEY_ST_DEB_RELEASE 4
+
+//Key event codes : bits 0-4 key value, bits 5-6 event type
+#define KEY_EV_PRESS     0x20
+#define KEY_EV_RELEASE   0x40
+#define KEY_EV_REPEAT    0x60
+#define KEY_EV_TYPE_MASK 0x60
+#define KEY_EV_KEY_MASK  0x1F
+#define KEY_NONE         0xFF	//no event / no key available
+
+//Key event queue size (must be a power of 2)
+#define KEY_EVQ_SIZE 16
+#define KEY_EVQ_MASK (KEY_EVQ_SIZE-1)
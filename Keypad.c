@@ -4,6 +4,10 @@ Purpose: Configure 4x4 keypad interfacing on LPC21xx ARM7 MCU
 using GPIO port P1.16P1.19 (Rows as output) and P1.20P1.23
 (Columns as input). Provides key detection and key value read
 functions with debounce handling.
+The matrix is scanned from the Timer1 match interrupt every
+KEY_SCAN_US. A per-key debounce state machine pushes press,
+release and auto-repeat events into a small queue which the
+application reads without blocking.
 ===============================================================*/
 
 // Header with LPC21xx register definitions
@@ -12,10 +16,28 @@ functions with debounce handling.
 // Header file containing project-specific pin macros & prototypes
 #include "Mini_headers.h"
 
+//---------------------------------------------------------
+// Key event queue filled by Timer1_ISR, read by main loop
+//---------------------------------------------------------
+
+volatile u8 keyEvQ[KEY_EVQ_SIZE];
+volatile u8 keyEvHead=0,keyEvTail=0;
+volatile u32 keyEvOvfCnt=0;		// Events dropped because queue was full
+
+//---------------------------------------------------------
+// Debounce state and tick counter for each of the 16 keys
+//---------------------------------------------------------
+
+u8 keyState[16];
+u8 keyCnt[16];
+
+void Timer1_ISR(void) __irq;
+
 //---------------------------------------------------------
 // Function: KeyPdInit
-// Purpose : Initialize GPIO pins for keypad rows as output
-//           and clear row pins to logic LOW (0)
+// Purpose : Initialize GPIO pins for keypad rows as output,
+//           clear row pins to logic LOW (0) and start the
+//           Timer1 driven keypad scan
 //---------------------------------------------------------
 
 void KeyPdInit(void)
@@ -25,6 +47,14 @@ void KeyPdInit(void)
 	
 	  // Clear ROW pins to 0 (initialize all rows LOW)
 		IOCLR1=((1<<R0)|(1<<R1)|(1<<R2)|(1<<R3));
+	
+		// Timer1 is the microsecond timebase, MR0 interrupt every KEY_SCAN_US
+		Timebase_Init();
+		T1MR0=T1TC+KEY_SCAN_US;
+		T1MCR|=1<<MR0I_BIT;
+	
+		// Install Timer1 ISR in its VIC vectored slot
+		VicInstall(VIC_SLOT_TIMER1,TIMER1_VIC_CHNO,(u32)Timer1_ISR,"T1");
 }
 
 //---------------------------------------------------------
@@ -51,96 +81,213 @@ u8 ColStat(void)
 }
 
 //------------------------------------------------------------
-// Function: KeyVal
-// Purpose : Identify pressed key position (Row, Column) and return
-//           corresponding value from lookup table
-// Method  : Sequential row scanning and column status check
-// Return  : Keypad decoded value (016)
+// Function: KeyScanMatrix
+// Purpose : Read raw state of all 16 keys
+// Method  : Drive one row LOW at a time and sample the columns
+//           after KEY_SETTLE_US, so a column released by the
+//           previous row has risen through its pull-up
+// Return  : Bit (row*4+col) set for every key currently closed
+// Note    : Runs in Timer1_ISR; adds about 4*KEY_SETTLE_US s
 //------------------------------------------------------------
 
-u8 KeyVal(void)
+static u32 KeyScanMatrix(void)
 {
-		char row_val=0,col_val=0;
+		u32 row,raw=0;
 	
-		// Scan ROW0
-		IOCLR1=(1<<R0);
-		IOSET1=((1<<R1)|(1<<R2)|(1<<R3));
-		if((((IOPIN1>>20)&0x0f)!=0x0f))
+		for(row=0;row<4;row++)
 		{
-			row_val=0;
-			goto colcheck;
+			IOSET1=ROW_MASK;
+			IOCLR1=1<<(R0+row);
+			
+			// Let the column lines settle on the slow GPIO
+			delay_us(KEY_SETTLE_US);
+			
+			// Columns read LOW for pressed keys
+			raw|=((~(IOPIN1>>C0))&0x0F)<<(row*4);
 		}
-		
-		// Scan ROW1
-		IOCLR1=(1<<R1);
-		IOSET1=((1<<R0)|(1<<R2)|(1<<R3));
-		if((((IOPIN1>>20)&0x0f)!=0x0f))
-		{
-			row_val=1;
-			goto colcheck;
-		}
-		
-		// Scan ROW2
-		IOCLR1=(1<<R2);
-		IOSET1=((1<<R0)|(1<<R1)|(1<<R3));
-		if((((IOPIN1>>20)&0x0f)!=0x0f))
+	
+		// Leave all rows LOW so ColStat() keeps working
+		IOCLR1=ROW_MASK;
+	
+		return raw;
+}
+
+//------------------------------------------------------------
+// Function: KeyPushEvent
+// Purpose : Append event to key event queue (ISR side)
+// Argument: ev ? event type OR'ed with key value
+//------------------------------------------------------------
+
+static void KeyPushEvent(u8 ev)
+{
+		u8 next=(keyEvHead+1)&KEY_EVQ_MASK;
+	
+		if(next==keyEvTail)
 		{
-			row_val=2;
-			goto colcheck;
+			keyEvOvfCnt++;
+			return;
 		}
-		
-		// Scan ROW3
-		IOCLR1=(1<<R3);
-		IOSET1=((1<<R0)|(1<<R1)|(1<<R2));
-		if((((IOPIN1>>20)&0x0f)!=0x0f))
-			row_val=3;
-		
-		colcheck:
-		
-		// Detect which column is LOW (pressed)
-		if(((IOPIN1>>C0)&1)==0)
-			col_val=0;
-		else if(((IOPIN1>>C1)&1)==0)
-			col_val=1;
-		else if(((IOPIN1>>C2)&1)==0)
-			col_val=2;
-		else
-			col_val=3;
-
-		// Clear all rows after scanning
-		IOCLR1=((1<<R0)|(1<<R1)|(1<<R2)|(1<<R3));
-
-		  // Return key from lookup table
-		return(KEY[row_val][col_val]);
+		keyEvQ[keyEvHead]=ev;
+		keyEvHead=next;
 }
 
 //------------------------------------------------------------
-// Function: GetKeyPress
-// Purpose : Wait for key press, read key value, and wait for release
-//           Implements debounce delay before press and after release
-// Return  : Decoded key value (integer)
+// Function: KeyScanTick
+// Purpose : Run debounce state machine of every key once
+// States  : IDLE -> DEB_PRESS -> PRESSED -> REPEAT
+//           PRESSED/REPEAT -> DEB_RELEASE -> IDLE
 //------------------------------------------------------------
 
-int GetKeyPress(void)
+static void KeyScanTick(void)
 {
-    int key;
+		u32 raw=KeyScanMatrix();
+		u8 k,down,val;
+	
+		for(k=0;k<16;k++)
+		{
+			down=(raw>>k)&1;
+			val=KEY[k>>2][k&3];
+			
+			switch(keyState[k])
+			{
+				case KEY_ST_IDLE:
+					if(down)
+					{
+						keyState[k]=KEY_ST_DEB_PRESS;
+						keyCnt[k]=0;
+					}
+					break;
+				
+				case KEY_ST_DEB_PRESS:
+					if(!down)
+						keyState[k]=KEY_ST_IDLE;
+					else if(++keyCnt[k]>=KEY_DEBOUNCE_TICKS)
+					{
+						keyState[k]=KEY_ST_PRESSED;
+						keyCnt[k]=0;
+						KeyPushEvent(KEY_EV_PRESS|val);
+					}
+					break;
+				
+				case KEY_ST_PRESSED:
+				case KEY_ST_REPEAT:
+					if(!down)
+					{
+						keyState[k]=KEY_ST_DEB_RELEASE;
+						keyCnt[k]=0;
+					}
+					else if(++keyCnt[k]>=((keyState[k]==KEY_ST_PRESSED)?KEY_REPEAT_DELAY:KEY_REPEAT_RATE))
+					{
+						keyState[k]=KEY_ST_REPEAT;
+						keyCnt[k]=0;
+						KeyPushEvent(KEY_EV_REPEAT|val);
+					}
+					break;
+				
+				case KEY_ST_DEB_RELEASE:
+					if(down)
+					{
+						// Contact bounce, key still held
+						keyState[k]=KEY_ST_PRESSED;
+						keyCnt[k]=0;
+					}
+					else if(++keyCnt[k]>=KEY_DEBOUNCE_TICKS)
+					{
+						keyState[k]=KEY_ST_IDLE;
+						KeyPushEvent(KEY_EV_RELEASE|val);
+					}
+					break;
+			}
+		}
+}
 
-    // Wait until any key is pressed
-    while(!ColStat());  
+//------------------------------------------------------------
+// Function: Timer1_ISR
+// Purpose : Periodic keypad scan on Timer1 MR0 match and the
+//           scheduler tick on MR1 match. Both match registers are
+//           advanced so T1TC keeps free-running. Latency is T1TC
+//           past the match value, both count s.
+//------------------------------------------------------------
 
-		// Debounce delay to avoid false triggering
-    delay_ms(20);       
+void Timer1_ISR(void) __irq
+{
+		u32 t0=VicIsrEnter();
+		u32 ir=T1IR;
+	
+		if(READBIT(ir,MR1_INT_BIT))
+		{
+			VicLatency(VIC_SLOT_TIMER1,t0-T1MR1);
+			T1IR=1<<MR1_INT_BIT;
+			SchedTick();
+		}
+	
+		if(READBIT(ir,MR0_INT_BIT))
+		{
+			// Clear MR0 interrupt flag and schedule next scan
+			VicLatency(VIC_SLOT_TIMER1,t0-T1MR0);
+			T1IR=1<<MR0_INT_BIT;
+			T1MR0+=KEY_SCAN_US;
+	
+			KeyScanTick();
+		}
+	
+		VicIsrExit(VIC_SLOT_TIMER1,t0);
+	
+		// Acknowledge interrupt to VIC
+		VICVectAddr=0;
+}
 
-    // Read key value from scanned row/column
-    key = KeyVal();
+//------------------------------------------------------------
+// Function: GetKeyEvent
+// Purpose : Remove oldest event from key event queue
+// Return  : Event code (KEY_EV_xxx | key value) or KEY_NONE
+//------------------------------------------------------------
 
-    // Wait until key is released
-    while(ColStat()); 
+u8 GetKeyEvent(void)
+{
+		u8 ev;
+	
+		if(keyEvTail==keyEvHead)
+			return KEY_NONE;
+		ev=keyEvQ[keyEvTail];
+		keyEvTail=(keyEvTail+1)&KEY_EVQ_MASK;
+		return ev;
+}
 
-		// Debounce delay after release
-    delay_ms(20);           
+//------------------------------------------------------------
+// Function: KeyVal
+// Purpose : Non-blocking read of next key press or auto-repeat
+//           (release events are discarded)
+// Return  : Keypad decoded value (016) or KEY_NONE
+//------------------------------------------------------------
 
-    return key;
+u8 KeyVal(void)
+{
+		u8 ev;
+	
+		while((ev=GetKeyEvent())!=KEY_NONE)
+		{
+			if((ev&KEY_EV_TYPE_MASK)!=KEY_EV_RELEASE)
+				return(ev&KEY_EV_KEY_MASK);
+		}
+		return KEY_NONE;
 }
 
+//------------------------------------------------------------
+// Function: GetKeyPress
+// Purpose : Non-blocking read of next debounced key press
+//           (auto-repeat and release events are discarded)
+// Return  : Decoded key value (integer) or KEY_NONE
+//------------------------------------------------------------
 
+int GetKeyPress(void)
+{
+		u8 ev;
+	
+		while((ev=GetKeyEvent())!=KEY_NONE)
+		{
+			if((ev&KEY_EV_TYPE_MASK)==KEY_EV_PRESS)
+				return(ev&KEY_EV_KEY_MASK);
+		}
+		return KEY_NONE;
+}
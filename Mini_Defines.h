@@ -23,6 +23,59 @@ embedded mini-project involving:
 #define RW 11				  // Read/Write Select  P0.11
 #define EN 12				  // Enable pulse  P0.12
 
+//---------------------------------------------------------
+// LCD geometry for the shadow frame buffer
+//---------------------------------------------------------
+#define LCD_ROWS 2
+#define LCD_COLS 16
+#define LCD_CELLS (LCD_ROWS*LCD_COLS)
+#define LCD_ADDR_UNKNOWN 0xFF	// DDRAM address counter not tracked
+
+//---------------------------------------------------------
+// LCD busy flag polling (comment out LCD_BUSY_POLL to use
+// fixed millisecond delays after every LCD write)
+//---------------------------------------------------------
+#define LCD_BUSY_POLL
+#define LCD_BF_PIN 9						// Busy flag DB7  P0.9
+#define LCD_BUSY_TIMEOUT_US 5000	// Max busy time (s) before fallback
+
+//---------------------------------------------------------
+// UART log timestamp format (define LOG_EPOCH_TS to log
+// seconds since 1970 instead of HH:MM:SS DD/MM/YYYY)
+//---------------------------------------------------------
+//#define LOG_EPOCH_TS
+
+//---------------------------------------------------------
+// Log record severity and formatting buffer size
+//---------------------------------------------------------
+#define LOG_SEV_NORMAL 0
+#define LOG_SEV_ALERT  1
+#define LOG_REC_MAX    80	// Longest record is 70 bytes + NUL
+
+//---------------------------------------------------------
+// Log output mode : ASCII lines for terminals, or binary
+// COBS/CRC-16 frames (frame_defines_mini.h) for a host logger
+//---------------------------------------------------------
+#define LOG_MODE_ASCII   0
+#define LOG_MODE_BINARY  1
+#define LOG_MODE_DEFAULT LOG_MODE_ASCII
+
+//---------------------------------------------------------
+// Binary mode sample batching : a FRAME_TYPE_BATCH frame is
+// sent after LOG_BATCH_N samples of a channel or once the
+// oldest sample is LOG_BATCH_MS old (LogBatchConfig at run time)
+//---------------------------------------------------------
+#define LOG_BATCH_N  64
+#define LOG_BATCH_MS 1000
+
+//---------------------------------------------------------
+// UART command interface (cmd.c)
+//---------------------------------------------------------
+#define CMD_LINE_MAX 40		// Longest command line incl. NUL
+//Longest GET STATS first line: "STATS" + 5 x " key=<u32>" + "\n\r"
+#define CMD_STATS_LINE_MAX (5+5*(1+7+1+10)+2)	// 102 bytes
+#define CMD_SP_MAX   150	// Highest setpoint (LM35 range), SET SP and keypad editor
+
 //-------------------------------------------------------------------
 // Configuration functions for selecting GPIO and etc.. Pin Mapping
 //-------------------------------------------------------------------
@@ -37,6 +90,64 @@ embedded mini-project involving:
 #define LED 16 // Status LED output  P0.16
 #define SW 17	 // External switch input  P0.17
 
+//---------------------------------------------------------
+// PCON power control: idle mode stops the CPU clock only,
+// peripherals keep running and any enabled interrupt wakes it
+//---------------------------------------------------------
+#define PCON_IDL_BIT 0
+
+//---------------------------------------------------------
+// Cooperative scheduler (sched.c) : tick, table size and the
+// period / deadline of each application task in ticks
+//---------------------------------------------------------
+#define SCHED_TICK_US   1000		// Timer1 MR1 tick
+#define SCHED_MAX_TASKS 8
+#define SCHED_NAME_MAX  8				// Longest task name (SchedAdd rejects longer)
+//Longest SchedReport line "TASK <name> runs=<u32> miss=<u32> wcet=<u32>us\n\r"
+#define SCHED_LINE_MAX  (5+SCHED_NAME_MAX+6+10+6+10+6+10+4)	// 65 bytes
+#define SCHED_MS(ms)    ((ms)*1000UL/SCHED_TICK_US)
+
+#define TASK_SAMPLE_MS  10			// Drain sample ring, batch samples
+#define TASK_ALERT_MS   100			// Pick up alert state from ADC_ISR comparator
+#define TASK_LOG_MS     10			// Detect RTC second, emit log record
+#define TASK_DISPLAY_MS 50			// Repaint monitoring screen when due
+#define TASK_KEYPAD_MS  10			// Edit switch and edit menu step
+#define TASK_CMD_MS     2				// UART command lines
+
+//------------------------------------------------------------
+// Clock Setup Prototypes (PLL, VPB divider, MAM)
+//------------------------------------------------------------
+void Clock_Init(void);			// PLL to CCLK, VPBDIV to PCLK, MAM fully on
+u32 Get_CCLK(void);				// Achieved core clock in Hz
+u32 Get_PCLK(void);				// Achieved peripheral clock in Hz
+void ClockReport(void);			// Achieved clocks and MAM setting over UART
+
+//------------------------------------------------------------
+// VIC Prototypes (vectored slots, critical sections, IRQ counters)
+//------------------------------------------------------------
+void VicInit(void);														// Disable all, default vector
+void VicInstall(u32 slot,u32 chNo,u32 isr,s8 *name);	// ISR in slot VIC_SLOT_x as IRQ, enable
+u32 VicMask(u32 chMask);											// Mask channels, return previously enabled
+void VicRestore(u32 saved);										// Re-enable channels saved by VicMask
+u32 VicIsrEnter(void);												// ISR entry timestamp (s)
+void VicIsrExit(u32 slot,u32 t0);							// Count invocation and service time
+void VicLatency(u32 slot,u32 us);							// Record match-to-entry latency
+u32 VicCount(u32 slot);												// Invocations of slot
+u32 VicMaxUs(u32 slot);												// Longest service time of slot (s)
+u32 VicMaxLatUs(u32 slot);										// Longest latency of slot (s)
+void VicReport(void);													// Per slot counters over UART
+
+//------------------------------------------------------------
+// Timebase & Delay Function Prototypes (Timer1, 1 s count)
+//------------------------------------------------------------
+void Timebase_Init(void);		// Start Timer1 microsecond timebase (idempotent)
+u32 Micros(void);					// Current timebase count in s
+u32 DeadlineSet(u32 us);		// Deadline us s from now
+u32 DeadlinePassed(u32 dl);	// 1 once deadline dl has been reached
+void delay_us(unsigned int tdly);	// Blocking delay, microseconds
+void delay_ms(unsigned int tdly);	// Blocking delay, milliseconds
+void delay_s(unsigned int tdly);	// Blocking delay, seconds
+
 //------------------------------------------------------------
 // UART0 Function Prototypes
 //------------------------------------------------------------
@@ -45,6 +156,14 @@ void UARTTxChar(s8 ch);		 // Transmit a single character via UART0
 void UARTTxStr(s8 *ptr);	 // Transmit a null-terminated string via UART0
 void UARTTxU32(u32 num);	 // Transmit 32-bit unsigned integer via UART0
 void UARTTxF32(f32 fnum);	 // Transmit float value via UART0 (6 decimal places)
+void UARTTxMilli(s32 num);	 // Transmit millis value as fixed point (3 decimal places)
+void UARTTxFlush(void);	 // Wait until all queued UART0 bytes are sent
+void UARTTxWait(u32 len);	 // Wait until the TX ring has room for len bytes
+u32 UARTTxSpan(u8 *buf, u32 len); // Queue len bytes as one unit (all or none)
+u32 UARTTxOvfCount(void);	 // Number of bytes dropped on TX ring overflow
+s8 UARTRxChar(void);			 // Wait for and return one received character
+u32 UARTRxGet(u8 *ch);		 // Non-blocking receive from RX ring, 0 if empty
+u32 UARTRxOvfCount(void);	 // Number of bytes dropped on RX ring overflow
 
 //------------------------------------------------------------
 // RTC Function Prototypes
@@ -55,17 +174,74 @@ void DisplayRTCTime(u32 hour, u32 minute, u32 second);			// Display time on LCD
 void GetRTCDateInfo(s32 *date, s32 *month, s32 *year);			// Read current RTC date
 void DisplayRTCDate(u32 date, u32 month, u32 year);					// Display date on LCD in DD/MM/YYYY
 void SetRTCTimeInfo(u32 hour, u32 minute, u32 second);			// Write new Hour, Minute and Second
-void SetRTCDateInfo(u32 date, u32 month, u32 year);					// Write new Date, Month and Year
+void SetRTCDateInfo(u32 date, u32 month, u32 year);					// Write new Date, Month and Year (+ DOW, DOY)
 void GetRTCDay(s32 *day);																	  // Read Day of Week (0=SUN  6=SAT)
 void SetRTCDay(u32 day);																		// Write new Day of Week into RTC
 void DisplayRTCDay(u32 dow);																// Display 3-character day string on L
+u32 GetRTCTimestamp(void);																// Consistent date+time as packed u32
+u32 GetRTCTimestampMs(u16 *ms);														// Packed timestamp plus milliseconds (0-999)
+u32 RTCTsToEpoch(u32 ts);																// Packed timestamp to seconds since 1970
+void RTC_TickInit(void);																	// Enable 1 Hz RTC counter-increment interrupt
+u32 GetRTCTicks(void);																		// RTC seconds ticked since RTC_TickInit
+
+//------------------------------------------------------------
+// Log Record Prototypes
+//------------------------------------------------------------
+void LogRecord(u32 sev, u32 ch, s32 mDeg, u32 ts, u16 ms);				// Format + queue one temperature record
+void LogSetMode(u32 mode);																		// LOG_MODE_ASCII or LOG_MODE_BINARY
+void LogBatchConfig(u32 maxN, u32 maxMs);													// Batch size / flush deadline, maxN 0 = off
+void LogBatchAdd(const ADCSample *smp);														// Append sample to its channel batch
+void LogBatchPoll(void);																			// Send batches past their flush deadline
+
+//------------------------------------------------------------
+// UART Command Interface Prototypes
+//------------------------------------------------------------
+void CmdPoll(void);																					// Run received command lines, non-blocking
+
+//------------------------------------------------------------
+// Binary Frame Prototypes
+//------------------------------------------------------------
+u16 Crc16(const u8 *buf, u32 len, u16 crc);												// Table driven CRC-16/CCITT update
+u32 CobsEncode(const u8 *src, u32 len, u8 *dst);										// COBS encode, returns encoded length
+u32 FrameSend(const u8 *payload, u32 len);													// CRC + COBS + delimiter, queue on UART0
+
+//------------------------------------------------------------
+// Decimal Formatting Prototypes
+//------------------------------------------------------------
+u32 FmtU32(u8 *buf, u32 num, u32 width);										// Unsigned to decimal string, zero padded to width
+
+//------------------------------------------------------------
+// Calendar (civil date <-> days since 1970-01-01) Prototypes
+//------------------------------------------------------------
+u32 IsLeapYear(s32 y);																		// Gregorian leap year test
+u32 DaysInMonth(s32 y, u32 m);																// 28  31 days in month m of year y
+s32 DaysFromCivil(s32 y, u32 m, u32 d);												// Date to days since 1970-01-01
+void CivilFromDays(s32 z, s32 *y, u32 *m, u32 *d);							// Days since 1970-01-01 to date
+u32 WeekdayFromDays(s32 z);																// Day of week (0=SUN  6=SAT)
+u32 DayOfYear(s32 y, u32 m, u32 d);														// Ordinal day within year (1  366)
 
 //------------------------------------------------------------
 // ADC + LM35 Temperature Sensor Function Prototypes
 //------------------------------------------------------------
 void Init_ADC(u32 chNo);															// Initialize ADC channel on AIN pins
 void Read_ADC(u32 chNo, f32 *eAR, u32 *adcDVal);			// Start ADC, wait DONE, read 10-bit
+u32 Read_ADCVal(u32 chNo);														// Start ADC, wait DONE, return 10-bit code
 f32 Read_LM35_NP(u8 tType);														// Differential LM35 temperature read
+void Start_ADCSampler(u32 chNo,u32 rateHz);					// Timer0 paced sampling into sample ring
+u32 Get_ADCSample(ADCSample *smp);										// Pop oldest sample, 0 if ring empty
+u32 Get_ADCOvfCount(void);														// Samples dropped on full sample ring
+u32 Get_ADCDropCount(void);														// Sampler ticks lost (ring full or ADC busy)
+u32 Get_ADCRate(void);																// Sampler rate in Hz
+void Set_ADCOversample(u32 chNo,u32 extraBits);			// Per-channel oversampling, 4^n conversions
+void Start_ADCScan(u32 chMask);												// BURST mode scan of channel mask
+u32 Get_ADCLatest(u32 chNo,u32 *code,u32 *ovs);				// Latest scanned result of a channel
+void Set_ADCAlert(u32 chNo,s32 mDeg);									// Over-temperature comparator in ADC_ISR, drives LED
+u32 Get_ADCAlert(void);																// 1 while channel is over the alert setpoint
+f32 Conv_LM35(u32 adcDVal);														// ADC code to LM35 temperature in C
+s32 Read_LM35_mDeg(u8 tType);													// Integer LM35 read in mC / mF
+s32 Conv_LM35_mC(u32 chNo,u32 adcDVal);								// ADC code to calibrated mC (table lookup)
+s32 Conv_LM35_mDeg(u32 chNo,u32 adcDVal,u8 tType);		// ADC code to calibrated mC / mF
+s32 Conv_LM35_mC_OS(u32 chNo,u32 code,u32 extraBits);	// Oversampled code to mC (interpolated)
 void DisplayTemp(u32 temp);													 	// Display 2-digit temperature on LCD
 
 //------------------------------------------------------------
@@ -77,19 +253,56 @@ void CharLCD(u8 dat);		// Send LCD data character (RS=1)
 void DispLCD(u8 val);		// Write byte to LCD data lines, generate EN pulse
 void StrLCD(u8 *ptr);		// Print string on LCD
 void IntLCD(s32 num);		// Print signed integer on LCD
+void FbGotoLCD(u8 addr);	// Set frame buffer position (0x80/0xC0 based)
+void FbCharLCD(u8 dat);	// Write character into frame buffer only
+void FbStrLCD(u8 *ptr);	// Write string into frame buffer only
+void FlushLCD(void);		// Send changed frame buffer cells to LCD
 
 //------------------------------------------------------------
 // Keypad Function Prototype
 //------------------------------------------------------------
 void KeyPdInit(void);
 u8 ColStat(void);					// Detect if any keypad column pin is LOW (pressed)
-u8 KeyVal(void);					// Scan keypad rows and decode active column to return mapped key from lookup table
-int GetKeyPress(void);		// Wait for key press ? read key ? wait for release
+u8 KeyVal(void);					// Next key press/auto-repeat from event queue, KEY_NONE if empty
+u8 GetKeyEvent(void);			// Next raw key event (press/release/repeat), KEY_NONE if empty
+int GetKeyPress(void);		// Next debounced key press from event queue, KEY_NONE if empty
+
+//---------------------------------------------------------
+// Edit menu states, keys and timing
+//---------------------------------------------------------
+#define MENU_IDLE      0	// Monitoring screen, menu inactive
+#define MENU_MAIN      1	// 1.EDIT RTC INFO / 2.E.SET / 3.EXT
+#define MENU_FIELD_SEL 2	// RTC field selection
+#define MENU_FIELD     3	// Editing one RTC field
+#define MENU_SETPOINT  4	// Editing temperature setpoint
+#define MENU_MSG       5	// Timed message screen
+
+#define EDIT_FIELDS 6			// Hour, Min, Sec, Date, Month, Year (day of week is derived)
+#define KEY_INC 15				// Increment key
+#define KEY_DEC 16				// Decrement key
+#define KEY_OK  13				// Save / exit key
+#define MENU_MSG_US 1200000	// Message screen time in us (Timer1 count)
+
+//------------------------------------------------------------
+// Main System Initialization and Task Prototypes
+//------------------------------------------------------------
+void System_Init(void);		// Default RTC, start sampling and RTC tick
+void MenuStep(void);			// Advance edit menu by one key event (non-blocking)
+void TaskSample(void);		// Drain sample ring into current temperature
+void TaskAlert(void);			// Over-temperature state for log records
+void TaskLog(void);				// Once per RTC second: read clock, log record
+void TaskDisplay(void);		// Repaint monitoring screen
+void TaskKeypad(void);		// Edit switch and edit menu
+void TaskCmd(void);				// UART command interface
 
 //------------------------------------------------------------
-// Main System Initialization Function Prototype
+// Scheduler Prototypes
 //------------------------------------------------------------
-void System_Init(void);
+u32 SchedAdd(s8 *name, void (*run)(void), u32 period, u32 deadline);	// Register task, period/deadline in ticks
+void SchedStart(void);																			// Start tick, run tasks forever
+void SchedTick(void);																				// Tick from Timer1 MR1 interrupt
+u32 SchedTicks(void);																				// Ticks since start
+void SchedReport(void);																			// Per task runs/misses/WCET over UART
 
 
 
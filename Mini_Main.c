@@ -3,7 +3,7 @@ File    : main.c
 Purpose :
    - Entry point of the application
    - Initializes all hardware peripherals
-   - Transfers control to main system logic
+   - Registers the application tasks and starts the scheduler
 ===============================================================*/
 
 #include<LPC21xx.h>
@@ -12,22 +12,38 @@ Purpose :
 /*---------------------------------------------------------------
  Function : main
  Purpose  :
-   - Initialize UART for serial communication
+   - Set up PLL, VPB divider and MAM for CCLK/PCLK
+   - Reset the VIC; drivers install their ISRs in their slots
+   - Initialize UART for serial communication and report clocks
    - Initialize RTC for date and time keeping
    - Initialize ADC for LM35 temperature sensing
    - Initialize LCD for user display
    - Initialize keypad for user input
-   - Call System_Init() to start main application loop
+   - Call System_Init() to set up the application
+   - Register tasks (period, deadline) and run the scheduler
 ----------------------------------------------------------------*/
 int  main()
 {
 	
+    Clock_Init();   // PLL, VPB divider, MAM (before any PCLK user)
+    VicInit();      // All interrupts off until installed by a driver
     InitUART();     // Initialize UART for debugging & logging
+    ClockReport();  // Achieved CCLK/PCLK at boot
     RTC_Init();     // Initialize Real Time Clock module
     Init_ADC(CH1);  // Initialize ADC Channel 1 for LM35 sensor
     InitLCD();      // Initialize LCD display
     KeyPdInit();    // Initialize keypad interface
-    System_Init();  // Start main system operation (never returns)
+    System_Init();  // Default RTC, start sampling
+	
+    // Tasks run in table order when released: name, body, period, deadline
+    SchedAdd("sample", TaskSample, SCHED_MS(TASK_SAMPLE_MS), SCHED_MS(TASK_SAMPLE_MS));
+    SchedAdd("alert", TaskAlert, SCHED_MS(TASK_ALERT_MS), SCHED_MS(TASK_ALERT_MS));
+    SchedAdd("log", TaskLog, SCHED_MS(TASK_LOG_MS), SCHED_MS(TASK_LOG_MS));
+    SchedAdd("display", TaskDisplay, SCHED_MS(TASK_DISPLAY_MS), SCHED_MS(TASK_DISPLAY_MS));
+    SchedAdd("keypad", TaskKeypad, SCHED_MS(TASK_KEYPAD_MS), SCHED_MS(TASK_KEYPAD_MS));
+    SchedAdd("cmd", TaskCmd, SCHED_MS(TASK_CMD_MS), SCHED_MS(TASK_CMD_MS));
+	
+    SchedStart();   // Run tasks (never returns)
 
 }
 
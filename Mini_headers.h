@@ -5,17 +5,30 @@
    - Modularize code for readability and reusability
    - Enable hardware abstraction for easy maintenance
 ===============================================================*/
+#include "rtc_defines_mini.h"		// FOSC/CCLK/PCLK, used by the other define headers
+#include "clock_defines_mini.h"
+#include "clock_mini.h"
+#include "vic_defines_mini.h"
+#include "vic_mini.h"
 #include "adc_mini.h"
 #include "adc_defines_mini.h"
 #include "delay.h"
+#include "timer_defines_mini.h"
+#include "uart_defines_mini.h"
 #include "uart_mini.h"
 #include "lm35_mini.h"
 #include "types.h"
+#include "digits_mini.h"
 #include "pinconnect.h"
-#include "rtc_defines_mini.h"
 #include "lcd_mini.h"
 #include "defines.h"
 #include "rtc_mini.h"
+#include "date_mini.h"
+#include "frame_defines_mini.h"
+#include "frame_mini.h"
+#include "log_mini.h"
+#include "cmd_mini.h"
+#include "sched_mini.h"
 #include "KeyPdDefines.h"
 #include "keyPd.h"
 #include "Mini_Defines.h"
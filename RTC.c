@@ -7,6 +7,13 @@ functions. Displays:
 - Date in DD/MM/YYYY format
 - Day of the week (SUNSAT)
 on a 16x2 LCD using existing LCD driver functions.
+GetRTCTimestamp() reads the consolidated CTIME0/CTIME1 registers
+once (re-reading on a rollover) and returns a packed 32-bit
+timestamp; RTCTsToEpoch() converts it to seconds since 1970.
+GetRTCTimestampMs() adds the millisecond within that second from
+the CTC clock tick counter.
+RTC_TickInit() enables the once-per-second counter-increment
+interrupt that paces the main loop.
 ===============================================================*/
 
 // Header with LPC21xx register definitions
@@ -20,6 +27,9 @@ on a 16x2 LCD using existing LCD driver functions.
 //---------------------------------------------------------
 char week[][4] = {"SUN","MON","TUE","WED","THU","FRI","SAT"};
 
+// Seconds counted by the RTC increment interrupt
+volatile u32 rtcTicks=0;
+
 
 //------------------------------------------------------------
 // Function: RTC_Init
@@ -45,18 +55,64 @@ void RTC_Init(void)
 	#endif
 }
 
+//------------------------------------------------------------
+// Function: RTC_ISR
+// Purpose : Count RTC seconds (counter increment interrupt)
+//------------------------------------------------------------
+void RTC_ISR(void) __irq
+{
+	u32 t0=VicIsrEnter();
+	
+	// Clear the counter increment flag
+	ILR = 1<<RTCCIF_BIT;
+	
+	rtcTicks++;
+	
+	VicIsrExit(VIC_SLOT_RTC,t0);
+	VICVectAddr=0;
+}
+
+//------------------------------------------------------------
+// Function: RTC_TickInit
+// Purpose : Interrupt on every seconds increment, VIC_SLOT_RTC
+//------------------------------------------------------------
+void RTC_TickInit(void)
+{
+	// Interrupt whenever the seconds counter increments
+	CIIR = 1<<IMSEC_BIT;
+	
+	// Clear any stale counter increment / alarm flags
+	ILR = (1<<RTCCIF_BIT)|(1<<RTCALF_BIT);
+	
+	// Install RTC ISR in its VIC vectored slot
+	VicInstall(VIC_SLOT_RTC,RTC_VIC_CHNO,(u32)RTC_ISR,"RTC");
+}
+
+//------------------------------------------------------------
+// Function: GetRTCTicks
+// Purpose : Number of RTC seconds ticked since RTC_TickInit
+//------------------------------------------------------------
+u32 GetRTCTicks(void)
+{
+	return rtcTicks;
+}
+
 //------------------------------------------------------------
 // Function: U32LCD
-// Purpose : Display 4-digit unsigned integer on LCD (00009999)
+// Purpose : Render 4-digit unsigned integer into LCD frame buffer (00009999)
 // Argument: num ? 32-bit unsigned integer
 //------------------------------------------------------------
 
 void U32LCD(u32 num)
 {
-    CharLCD((num/1000)%10+48);  // thousands
-    CharLCD((num/100)%10+48);  // hundreds
-    CharLCD((num/10)%10+48);  // tens
-    CharLCD((num%10)+48); // ones
+    u32 hi=DIV100(num);
+    u32 lo=num-hi*100;
+    
+    hi=hi-DIV100(hi)*100;
+    FbCharLCD(DIG2_TENS(hi));  // thousands
+    FbCharLCD(DIG2_ONES(hi));  // hundreds
+    FbCharLCD(DIG2_TENS(lo));  // tens
+    FbCharLCD(DIG2_ONES(lo)); // ones
 }
 
 //------------------------------------------------------------
@@ -87,32 +143,32 @@ void SetRTCTimeInfo(u32 hour, u32 minute, u32 second)
 
 //------------------------------------------------------------
 // Function: DisplayRTCTime
-// Purpose : Display time on LCD in HH:MM:SS format
+// Purpose : Render time into LCD frame buffer in HH:MM:SS format
 // Arguments: hour (023), minute (059), second (059)
 //------------------------------------------------------------
 
 void DisplayRTCTime(u32 hour, u32 minute, u32 second)
 {
 		// Set cursor to 1st line start
-		CmdLCD(0x80);
+		FbGotoLCD(0x80);
 	
 		// Print hour
-		CharLCD((hour/10)+48);
-		CharLCD((hour%10)+48);
+		FbCharLCD(DIG2_TENS(hour));
+		FbCharLCD(DIG2_ONES(hour));
 	
 		// Separator
-		CharLCD(':');
+		FbCharLCD(':');
 	
 		// Print minute
-		CharLCD((minute/10)+48);
-		CharLCD((minute%10)+48);
+		FbCharLCD(DIG2_TENS(minute));
+		FbCharLCD(DIG2_ONES(minute));
 	
 		// Separator
-		CharLCD(':');
+		FbCharLCD(':');
 	
 		// Print second
-		CharLCD((second/10)+48);
-		CharLCD((second%10)+48);
+		FbCharLCD(DIG2_TENS(second));
+		FbCharLCD(DIG2_ONES(second));
 }
 
 //------------------------------------------------------------
@@ -131,41 +187,56 @@ void GetRTCDateInfo(s32 *date, s32 *month, s32 *year)
 
 //------------------------------------------------------------
 // Function: SetRTCDateInfo
-// Purpose : Write new date into RTC registers
+// Purpose : Write new date into RTC registers; day of week and
+//           day of year are derived from it
 // Arguments: date (131), month (112), year (4-digit)
+// Note    : year is limited to RTC_TS_YEAR_MIN-MAX (packed
+//           timestamp range), date to the length of the month
 //------------------------------------------------------------
 
 void SetRTCDateInfo(u32 date, u32 month, u32 year)
 {
+	s32 days;
+	
+	if(year < RTC_TS_YEAR_MIN)
+		year = RTC_TS_YEAR_MIN;
+	if(year > RTC_TS_YEAR_MAX)
+		year = RTC_TS_YEAR_MAX;
+	if(date > DaysInMonth(year,month))
+		date = DaysInMonth(year,month);
+	days = DaysFromCivil(year,month,date);
+	
 	DOM = date;
 	MONTH = month;
 	YEAR = year;	
+	DOW = WeekdayFromDays(days);
+	DOY = DayOfYear(year,month,date);
 }
 
 //------------------------------------------------------------
 // Function: DisplayRTCDate
-// Purpose : Display date on LCD in DD/MM/YYYY format
+// Purpose : Render date into LCD frame buffer in DD/MM/YYYY format
 // Arguments: date (131), month (112), year (4-digit)
 //------------------------------------------------------------
 
 void DisplayRTCDate(u32 date, u32 month, u32 year)
 {
 		// Set cursor to 2nd line start
-		CmdLCD(0xC0);
+		FbGotoLCD(0xC0);
 	
 		 // Print date
-		CharLCD((date/10)+48);
-		CharLCD((date%10)+48);
+		FbCharLCD(DIG2_TENS(date));
+		FbCharLCD(DIG2_ONES(date));
 	
 		 // Separator
-		CharLCD('/');
+		FbCharLCD('/');
 	
 		// Print month
-		CharLCD((month/10)+48);
-		CharLCD((month%10)+48);
+		FbCharLCD(DIG2_TENS(month));
+		FbCharLCD(DIG2_ONES(month));
 		
 		 // Separator
-		CharLCD('/');
+		FbCharLCD('/');
 	
 		// Print year
 		U32LCD(year);
@@ -186,6 +257,7 @@ void GetRTCDay(s32 *day)
 //------------------------------------------------------------
 // Function: SetRTCDay
 // Purpose : Write new day of week into RTC register
+//           (SetRTCDateInfo already keeps it in step with the date)
 // Argument: day (0=SUN  6=SAT)
 //------------------------------------------------------------
 void SetRTCDay(u32 day)
@@ -195,18 +267,87 @@ void SetRTCDay(u32 day)
 
 //------------------------------------------------------------
 // Function: DisplayRTCDay
-// Purpose : Display day of week string on LCD
+// Purpose : Render day of week string into LCD frame buffer
 // Argument: dow (0=SUN  6=SAT)
 //------------------------------------------------------------
 
 void DisplayRTCDay(u32 dow)
 {
 	// Set cursor near end of 2nd line (day position)
-	CmdLCD(0xcc);
+	FbGotoLCD(0xcc);
 	
 	// Print 3-char day string from lookup table
-	StrLCD((u8*)week[dow]);  
+	FbStrLCD((u8*)week[dow]);  
 }
 
+//------------------------------------------------------------
+// Function: GetRTCTimestamp
+// Purpose : Read date and time as one consistent value
+// Method  : CTIME0, CTIME1, then CTIME0 again; if the second
+//           changed in between (incl. midnight rollover) re-read
+// Return  : Packed timestamp (see RTC_TS_xxx in rtc_defines_mini.h)
+// Note    : No shared state, safe to call from ISRs
+//------------------------------------------------------------
+
+u32 GetRTCTimestamp(void)
+{
+	u32 ct0,ct1;
+	
+	do
+	{
+		ct0 = CTIME0;
+		ct1 = CTIME1;
+	}while(ct0 != CTIME0);
+	
+	return RTC_TS_PACK(CT1_YEAR(ct1),CT1_MONTH(ct1),CT1_DOM(ct1),
+	                   CT0_HOUR(ct0),CT0_MIN(ct0),CT0_SEC(ct0));
+}
 
+//------------------------------------------------------------
+// Function: GetRTCTimestampMs
+// Purpose : Read date, time and millisecond as one consistent value
+// Method  : CTC counts 32768 ticks per second and restarts with
+//           each seconds increment, so it is in step with CTIME0;
+//           read between two CTIME0 reads, retry on a rollover
+// Argument: ms - Pointer to store millisecond within the second
+// Return  : Packed timestamp (see RTC_TS_xxx in rtc_defines_mini.h)
+// Note    : No shared state, safe to call from ISRs
+//------------------------------------------------------------
 
+u32 GetRTCTimestampMs(u16 *ms)
+{
+	u32 ct0,ct1,ctc;
+	
+	do
+	{
+		ct0 = CTIME0;
+		ctc = CTC;
+		ct1 = CTIME1;
+	}while(ct0 != CTIME0);
+	
+	*ms = CTC_TO_MS(CTC_TICKS(ctc));
+	
+	return RTC_TS_PACK(CT1_YEAR(ct1),CT1_MONTH(ct1),CT1_DOM(ct1),
+	                   CT0_HOUR(ct0),CT0_MIN(ct0),CT0_SEC(ct0));
+}
+
+//------------------------------------------------------------
+// Function: RTCTsToEpoch
+// Purpose : Convert packed timestamp to seconds since
+//           1970-01-01 00:00:00 (Gregorian leap rules)
+// Argument: ts ? packed timestamp from GetRTCTimestamp()
+// Return  : Epoch seconds
+//------------------------------------------------------------
+
+u32 RTCTsToEpoch(u32 ts)
+{
+	u32 m = RTC_TS_MONTH(ts);
+	u32 days;
+	
+	if(m < 1 || m > 12)
+		m = 1;
+	
+	days = DaysFromCivil(RTC_TS_YEAR(ts),m,RTC_TS_DATE(ts));
+	
+	return days*86400 + RTC_TS_HOUR(ts)*3600 + RTC_TS_MIN(ts)*60 + RTC_TS_SEC(ts);
+}
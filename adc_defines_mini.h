@@ -5,13 +5,18 @@
 #define ADCCLK 3000000
 #define CLKDIV ((PCLK/ADCCLK)-1)
 
+//Longest wait for one polled conversion (11 ADC clocks ~ 4 s)
+#define ADC_CONV_TIMEOUT_US 100
+
 //defines for ADCR sfr
 #define CLKDIV_BITS        8 //@8-15
+#define BURST_BIT          16
 #define PDN_BIT            21
 #define ADC_CONV_START_BIT 24
 
 //defines for ADDR sfr
 #define DIGITAL_DATA_BITS 6//@6-15
+#define ADC_CHN_BITS      24//@24-26
 #define DONE_BIT          31
 
 #define AIN0_PIN_0_27 0x00400000
@@ -23,4 +28,69 @@
 #define CH1 1
 #define CH2 2
 #define CH3 3
+
+//10-bit ADC full-scale code
+#define ADC_MAX_CODE 1023
+
+//Lookup table size (one entry per 10-bit code)
+#define ADC_LUT_SIZE 1024
+
+//ADC reference voltage (V) and LM35 slope (mV/C) for lookup tables
+#define ADC_VREF        3.3
+#define LM35_MV_PER_DEG 10.0
+
+//Per-channel calibration : gain (1.0 = none) and offset in mC
+#define LM35_CAL0_GAIN   1.0
+#define LM35_CAL0_OFS_MC 0
+#define LM35_CAL1_GAIN   1.0
+#define LM35_CAL1_OFS_MC 0
+#define LM35_CAL2_GAIN   1.0
+#define LM35_CAL2_OFS_MC 0
+#define LM35_CAL3_GAIN   1.0
+#define LM35_CAL3_OFS_MC 0
+
+//start bits field of ADCR sfr
+#define ADC_START_MASK (7<<ADC_CONV_START_BIT)
+
+//Timer0 paced sampling : default rate and allowed range in Hz
+#define ADC_SAMPLE_HZ     10
+#define ADC_SAMPLE_HZ_MIN 10
+#define ADC_SAMPLE_HZ_MAX 1000
+
+//Oversampling extra bits n per channel (4^n conversions per sample)
+#define ADC_OVS_BITS_MAX 3	//13-bit effective resolution
+#define ADC_OVS_BITS_CH0 0
+#define ADC_OVS_BITS_CH1 2
+#define ADC_OVS_BITS_CH2 0
+#define ADC_OVS_BITS_CH3 0
+
+//Conversion budget : ~11 ADC clocks per conversion, keep half of it
+#define ADC_CONV_HZ_MAX (ADCCLK/11/2)
+#if (ADC_SAMPLE_HZ_MAX<<(2*ADC_OVS_BITS_MAX)) > ADC_CONV_HZ_MAX
+#error "Oversampling at ADC_SAMPLE_HZ_MAX exceeds ADC conversion budget"
+#endif
+
+//Burst-scan mode : slower ADC clock keeps DONE interrupts at
+//~ADC_SCAN_CLK/11 conversions per second shared by all channels
+#define ADC_SCAN_CLK    100000
+#define ADC_SCAN_CLKDIV ((PCLK/ADC_SCAN_CLK)-1)
+#if ADC_SCAN_CLKDIV > 255
+#error "ADC_SCAN_CLK too low for 8-bit CLKDIV"
+#endif
+
+//Channels scanned by the application (bit n = AINn)
+#define ADC_SCAN_MASK (1<<CH1)
+
+//VIC channel used for ADC
+#define ADC_VIC_CHNO 18
+
+//Over-temperature comparator in ADC_ISR : thresholds are raw codes
+//scaled to ADC_OVS_BITS_MAX extra bits, so channels with any
+//oversampling compare against the same values
+#define ADC_ALERT_OFF      0xFF	//No channel compared
+#define ADC_ALERT_CODE_END ((ADC_MAX_CODE<<ADC_OVS_BITS_MAX)+1)	//Codes 0 .. END-1
+
+//Sample ring size (must be a power of 2)
+#define ADC_RING_SIZE 128
+#define ADC_RING_MASK (ADC_RING_SIZE-1)
 //add mores defines as & when required
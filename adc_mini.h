@@ -1,4 +1,31 @@
 //adc.h
+#ifndef ADC_H
+#define ADC_H
+
 #include "types.h"
+
+//One timer-paced ADC sample as stored in the sample ring
+typedef struct
+{
+	u32 ts;		//Packed RTC timestamp (GetRTCTimestampMs) of the sample
+	u16 ms;		//Millisecond within ts (0-999)
+	u16 code;	//ADC result, 10+ovs bits
+	u8  ch;		//ADC channel number
+	u8  ovs;	//Extra bits from oversampling (0 = plain 10-bit)
+}ADCSample;
+
 void Init_ADC(u32 chNo);
 void Read_ADC(u32 chNo,f32 *eAR,u32 *adcDVal);
+u32 Read_ADCVal(u32 chNo);
+void Start_ADCSampler(u32 chNo,u32 rateHz);
+u32 Get_ADCSample(ADCSample *smp);
+u32 Get_ADCOvfCount(void);
+u32 Get_ADCDropCount(void);
+u32 Get_ADCRate(void);
+void Set_ADCOversample(u32 chNo,u32 extraBits);
+void Start_ADCScan(u32 chMask);
+u32 Get_ADCLatest(u32 chNo,u32 *code,u32 *ovs);
+void Set_ADCAlert(u32 chNo,s32 mDeg);
+u32 Get_ADCAlert(void);
+
+#endif
@@ -0,0 +1,115 @@
+/*===============================================================
+File: civil_date.c
+Purpose: Gregorian calendar arithmetic for the RTC and logger.
+Dates are converted to and from a day count relative to
+1970-01-01 using 400-year eras (146097 days), with March as the
+first month of the computational year so that the leap day falls
+at the end. No tables, no loops, valid for any s32 day count.
+- Leap years : divisible by 4, except centuries not divisible by 400
+- Weekday    : 0=SUN  6=SAT (1970-01-01 was a Thursday)
+- Day of year: 1  366
+===============================================================*/
+
+//Only needs its own header, so host/civil_date_test.c can build it too
+#include "date_mini.h"
+
+//---------------------------------------------------------
+// Days per 400-year era and offset of 1970-01-01 from 0000-03-01
+//---------------------------------------------------------
+
+#define DAYS_PER_ERA   146097
+#define EPOCH_DAY_OFS  719468
+
+//------------------------------------------------------------
+// Function: IsLeapYear
+// Purpose : Gregorian leap year test
+// Return  : 1 if y has 366 days, else 0
+//------------------------------------------------------------
+
+u32 IsLeapYear(s32 y)
+{
+			// y%100 != 0 is y%25 != 0 once y%4 == 0; y%400 == 0 is then y%16 == 0
+			return ((y&3)==0) && (((y%25)!=0) || ((y&15)==0));
+}
+
+//------------------------------------------------------------
+// Function: DaysInMonth
+// Purpose : Number of days in month m (112) of year y
+//------------------------------------------------------------
+
+u32 DaysInMonth(s32 y,u32 m)
+{
+			if(m==2)
+				return 28+IsLeapYear(y);
+	
+			// 31 for Jan,Mar,May,Jul,Aug,Oct,Dec; 30 for the rest
+			return 30+((m+(m>>3))&1);
+}
+
+//------------------------------------------------------------
+// Function: DaysFromCivil
+// Purpose : Date to days since 1970-01-01 (negative before)
+// Arguments: y - year, m - month (112), d - day of month (131)
+//------------------------------------------------------------
+
+s32 DaysFromCivil(s32 y,u32 m,u32 d)
+{
+			s32 era;
+			u32 yoe,doy,doe;
+	
+			// Jan and Feb belong to the previous March-based year
+			y-=(m<=2);
+			era=((y>=0)?y:y-399)/400;
+			yoe=(u32)(y-era*400);												// 0  399
+			doy=(153*((m>2)?m-3:m+9)+2)/5+d-1;					// 0  365
+			doe=yoe*365+yoe/4-yoe/100+doy;							// 0  146096
+	
+			return era*DAYS_PER_ERA+(s32)doe-EPOCH_DAY_OFS;
+}
+
+//------------------------------------------------------------
+// Function: CivilFromDays
+// Purpose : Days since 1970-01-01 to date
+// Arguments:
+// z - day count from DaysFromCivil
+// y, m, d - Pointers to store year, month (112), day (131)
+//------------------------------------------------------------
+
+void CivilFromDays(s32 z,s32 *y,u32 *m,u32 *d)
+{
+			s32 era;
+			u32 doe,yoe,doy,mp;
+	
+			z+=EPOCH_DAY_OFS;
+			era=((z>=0)?z:z-(DAYS_PER_ERA-1))/DAYS_PER_ERA;
+			doe=(u32)(z-era*DAYS_PER_ERA);											// 0  146096
+			yoe=(doe-doe/1460+doe/36524-doe/146096)/365;					// 0  399
+			doy=doe-(365*yoe+yoe/4-yoe/100);										// 0  365
+			mp=(5*doy+2)/153;																	// 0  11, March based
+	
+			*d=doy-(153*mp+2)/5+1;
+			*m=(mp<10)?mp+3:mp-9;
+			*y=(s32)yoe+era*400+(*m<=2);
+}
+
+//------------------------------------------------------------
+// Function: WeekdayFromDays
+// Purpose : Day of week for a day count from DaysFromCivil
+// Return  : 0=SUN  6=SAT
+//------------------------------------------------------------
+
+u32 WeekdayFromDays(s32 z)
+{
+			return (z>=-4)?(u32)(z+4)%7:(u32)((z+5)%7+6);
+}
+
+//------------------------------------------------------------
+// Function: DayOfYear
+// Purpose : Ordinal day of the date within its year
+// Return  : 1  366
+//------------------------------------------------------------
+
+u32 DayOfYear(s32 y,u32 m,u32 d)
+{
+			return (u32)(DaysFromCivil(y,m,d)-DaysFromCivil(y,1,1))+1;
+}
@@ -0,0 +1,124 @@
+/*===============================================================
+File: clock.c
+Functions: Clock_Init, Get_CCLK, Get_PCLK, ClockReport.
+Purpose:
+   - Configure the clocks the rest of the firmware assumes:
+     PLL to CCLK = FOSC*PLL_M, VPB divider to PCLK and the
+     Memory Accelerator Module fully enabled with MAMTIM_VAL
+     flash fetch cycles (clock_defines_mini.h, checked at
+     compile time against FOSC/CCLK/PCLK)
+   - Read back the achieved clocks from the PLL and VPB
+     registers and report them over UART
+Note: Clock_Init must run first in main(), before any driver
+      derives a divisor from PCLK, and before interrupts are
+      enabled (the PLL feed sequence must not be interrupted).
+      With CLOCK_SETUP 0 the startup file settings are kept.
+===============================================================*/
+
+// Header with LPC21xx register definitions
+#include<LPC21xx.h>
+
+// Header containing project-specific macros, typedefs & prototypes
+#include "Mini_headers.h"
+
+//------------------------------------------------------------
+// Function: Clock_Init
+// Purpose : MAM timing, VPB divider, then PLL lock and connect
+//           (MAM is set for the final CCLK first; more fetch
+//           cycles than needed is safe at the lower FOSC clock)
+//------------------------------------------------------------
+
+void Clock_Init(void)
+{
+#if CLOCK_SETUP
+	u32 n;
+
+	// MAM off while MAMTIM changes, then fully enabled
+	MAMCR=MAMCR_OFF;
+	MAMTIM=MAMTIM_VAL;
+	MAMCR=MAMCR_FULL;
+
+	VPBDIV=VPBDIV_VAL;
+
+	// Run from FOSC while the PLL is reconfigured
+	if(READBIT(PLLSTAT,PLLSTAT_PLLC_BIT))
+	{
+		PLLCON=1<<PLLE_BIT;
+		PLL_FEED();
+	}
+	PLLCON=0;
+	PLL_FEED();
+
+	PLLCFG=PLL_CFG_VAL;
+	PLLCON=1<<PLLE_BIT;
+	PLL_FEED();
+
+	// Wait for lock (bounded: no timebase exists yet)
+	for(n=0;n<PLL_LOCK_TIMEOUT;n++)
+	{
+		if(READBIT(PLLSTAT,PLOCK_BIT))
+			break;
+	}
+	if(n==PLL_LOCK_TIMEOUT)
+	{
+		// Leave the PLL off, CCLK stays at FOSC
+		PLLCON=0;
+		PLL_FEED();
+		return;
+	}
+
+	PLLCON=(1<<PLLE_BIT)|(1<<PLLC_BIT);
+	PLL_FEED();
+#endif
+}
+
+//------------------------------------------------------------
+// Function: Get_CCLK
+// Purpose : Core clock in Hz from the PLL status register
+//------------------------------------------------------------
+
+u32 Get_CCLK(void)
+{
+	u32 stat=PLLSTAT;
+
+	if(READBIT(stat,PLLSTAT_PLLC_BIT))
+		return FOSC*((stat&PLLSTAT_MSEL_MASK)+1);
+	return FOSC;
+}
+
+//------------------------------------------------------------
+// Function: Get_PCLK
+// Purpose : Peripheral clock in Hz from CCLK and VPBDIV
+//------------------------------------------------------------
+
+u32 Get_PCLK(void)
+{
+	switch(VPBDIV&VPBDIV_MASK)
+	{
+		case 1: return Get_CCLK();
+		case 2: return Get_CCLK()/2;
+		default: return Get_CCLK()/4;
+	}
+}
+
+//------------------------------------------------------------
+// Function: ClockReport
+// Purpose : Send achieved clocks and MAM setting over UART,
+//           with a warning if they differ from CCLK/PCLK
+//           that the drivers were compiled for
+//------------------------------------------------------------
+
+void ClockReport(void)
+{
+	u32 cclk=Get_CCLK(),pclk=Get_PCLK();
+
+	UARTTxStr("CLK CCLK=");
+	UARTTxU32(cclk);
+	UARTTxStr(" PCLK=");
+	UARTTxU32(pclk);
+	UARTTxStr(" MAM=");
+	UARTTxU32(MAMCR);
+	UARTTxStr("/");
+	UARTTxU32(MAMTIM);
+	UARTTxStr((cclk==CCLK && pclk==PCLK) ? " OK\n\r" : " MISMATCH\n\r");
+}
@@ -0,0 +1,80 @@
+#ifndef CLOCK_DEFINES_H
+#define CLOCK_DEFINES_H
+
+//Clock setup done by Clock_Init() from FOSC/CCLK/PCLK (rtc_defines_mini.h)
+//1 -> configure PLL, VPBDIV and MAM here
+//0 -> keep the settings made by the startup file
+#define CLOCK_SETUP 1
+
+//PLL multiplier and divider : CCLK = FOSC*M, FCCO = CCLK*2*P
+#define PLL_M    (CCLK/FOSC)
+#define PLL_MSEL (PLL_M-1)
+#define FCCO_MIN 156000000UL
+#define FCCO_MAX 320000000UL
+
+#if (CCLK*2UL >= FCCO_MIN)
+#define PLL_PSEL 0	//P=1
+#elif (CCLK*4UL >= FCCO_MIN)
+#define PLL_PSEL 1	//P=2
+#elif (CCLK*8UL >= FCCO_MIN)
+#define PLL_PSEL 2	//P=4
+#else
+#define PLL_PSEL 3	//P=8
+#endif
+#define PLL_P    (1UL<<PLL_PSEL)
+#define PLL_CFG_VAL (PLL_MSEL|(PLL_PSEL<<5))
+
+#if (FOSC < 10000000) || (FOSC > 25000000)
+#error "FOSC outside the 10-25 MHz PLL input range"
+#endif
+#if (CCLK % FOSC) || (PLL_M < 1) || (PLL_M > 32)
+#error "CCLK must be FOSC times 1..32"
+#endif
+#if (CCLK > 60000000)
+#error "CCLK above 60 MHz"
+#endif
+#if (CCLK*2UL*PLL_P > FCCO_MAX)
+#error "No PLL divider keeps FCCO in 156-320 MHz"
+#endif
+
+//defines for PLLCON sfr
+#define PLLE_BIT 0	//PLL enable
+#define PLLC_BIT 1	//PLL connect
+
+//defines for PLLSTAT sfr
+#define PLLSTAT_MSEL_MASK 0x1F
+#define PLLSTAT_PLLE_BIT  8
+#define PLLSTAT_PLLC_BIT  9
+#define PLOCK_BIT         10
+
+//PLL feed sequence, needed for PLLCON/PLLCFG writes to take effect
+#define PLL_FEED() do{ PLLFEED=0xAA; PLLFEED=0x55; }while(0)
+
+//Polls of PLOCK before giving up and running from FOSC
+#define PLL_LOCK_TIMEOUT 100000
+
+//VPBDIV value giving PCLK from CCLK : 0 -> /4, 1 -> /1, 2 -> /2
+#if (PCLK == CCLK)
+#define VPBDIV_VAL 1
+#elif (PCLK*2 == CCLK)
+#define VPBDIV_VAL 2
+#elif (PCLK*4 == CCLK)
+#define VPBDIV_VAL 0
+#else
+#error "PCLK must be CCLK, CCLK/2 or CCLK/4"
+#endif
+#define VPBDIV_MASK 0x03
+
+//MAM : fully enabled, flash fetch cycles for CCLK
+//(1 below 20 MHz, 2 below 40 MHz, 3 above)
+#define MAMCR_OFF  0
+#define MAMCR_FULL 2
+#if (CCLK < 20000000)
+#define MAMTIM_VAL 1
+#elif (CCLK < 40000000)
+#define MAMTIM_VAL 2
+#else
+#define MAMTIM_VAL 3
+#endif
+
+#endif
@@ -0,0 +1,12 @@
+//clock.h
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include "types.h"
+
+void Clock_Init(void);
+u32 Get_CCLK(void);
+u32 Get_PCLK(void);
+void ClockReport(void);
+
+#endif
@@ -0,0 +1,317 @@
+/*===============================================================
+File: cmd.c
+Purpose: Line oriented command interface on UART0.
+CmdPoll() is called from the main loop; it takes characters from
+the UART receive ring without blocking, collects one line in a
+static buffer and executes it on CR or LF. Keywords are not case
+sensitive. Every command answers "OK" or "ERR <reason>".
+  SET SP <degC>          alert setpoint, 0  CMD_SP_MAX
+  SET TIME hh:mm:ss      RTC time
+  SET DATE dd/mm/yyyy    RTC date, year RTC_TS_YEAR_MIN  MAX
+  SET MODE ASCII|BIN     log output mode
+  GET STATS              uptime, drop counters, task and IRQ timing
+  DUMP                   clock, settings and latest samples
+===============================================================*/
+
+//Header file containing project-specific definitions & prototypes
+#include "Mini_headers.h"
+
+#if CMD_STATS_LINE_MAX > UART_TX_BUF_SIZE-1
+#error "GET STATS line does not fit the UART transmit ring"
+#endif
+
+extern int setpoint;// Alert setpoint in C (mini_system_init1.c)
+extern u8 logMode;// Log output mode (log.c)
+extern char week[][4];// Weekday strings (RTC.c)
+
+u8 cmdLine[CMD_LINE_MAX];// Line being received
+u32 cmdLen=0;// Characters in cmdLine
+u8 cmdOvf=0;// 1 -> line too long, discard until end of line
+
+//------------------------------------------------------------
+// Function: CmdTok
+// Purpose : Split next space separated token off *pp
+// Return  : Token (NUL terminated in place), "" at end of line
+//------------------------------------------------------------
+
+static u8 *CmdTok(u8 **pp)
+{
+			u8 *p=*pp,*t;
+	
+			while(*p==' ')
+				p++;
+			t=p;
+			while(*p && *p!=' ')
+				p++;
+			if(*p)
+				*p++=0;
+			*pp=p;
+			return t;
+}
+
+//------------------------------------------------------------
+// Function: CmdStrEq
+// Purpose : Compare two NUL terminated strings
+//------------------------------------------------------------
+
+static u32 CmdStrEq(const u8 *a,const s8 *b)
+{
+			while(*a && *a==(u8)*b)
+			{
+				a++;
+				b++;
+			}
+			return *a==(u8)*b;
+}
+
+//------------------------------------------------------------
+// Function: CmdNums
+// Purpose : Parse n decimal fields separated by sep, e.g. 12:14:05
+// Arguments: s - Token, v - Values out, n - Field count, sep - Separator
+// Return  : 1 if the whole token matched, else 0
+//------------------------------------------------------------
+
+static u32 CmdNums(const u8 *s,u32 *v,u32 n,u8 sep)
+{
+			u32 i,digits;
+	
+			for(i=0;i<n;i++)
+			{
+				if(i && *s++!=sep)
+					return 0;
+				v[i]=0;
+				for(digits=0;*s>='0' && *s<='9';digits++)
+				{
+					if(digits==5)
+						return 0;
+					v[i]=v[i]*10+(*s++-'0');
+				}
+				if(!digits)
+					return 0;
+			}
+			return *s==0;
+}
+
+//------------------------------------------------------------
+// Function: CmdReply
+// Purpose : Send "OK" or "ERR <why>" line
+//------------------------------------------------------------
+
+static void CmdReply(s8 *why)
+{
+			if(why)
+			{
+				UARTTxStr("ERR ");
+				UARTTxStr(why);
+			}
+			else
+				UARTTxStr("OK");
+			UARTTxStr("\n\r");
+}
+
+//------------------------------------------------------------
+// Function: CmdSet
+// Purpose : SET SP / TIME / DATE / MODE
+// Return  : 0 on success, else error text
+//------------------------------------------------------------
+
+static s8 *CmdSet(u8 *p)
+{
+			u8 *what=CmdTok(&p);
+			u8 *arg=CmdTok(&p);
+			u32 v[3];
+	
+			if(*CmdTok(&p))
+				return "ARGS";
+	
+			if(CmdStrEq(what,"SP"))
+			{
+				if(!CmdNums(arg,v,1,0) || v[0]>CMD_SP_MAX)
+					return "RANGE";
+				setpoint=v[0];
+				Set_ADCAlert(CH1,setpoint*1000);
+			}
+			else if(CmdStrEq(what,"TIME"))
+			{
+				if(!CmdNums(arg,v,3,':') || v[0]>23 || v[1]>59 || v[2]>59)
+					return "RANGE";
+				SetRTCTimeInfo(v[0],v[1],v[2]);
+			}
+			else if(CmdStrEq(what,"DATE"))
+			{
+				if(!CmdNums(arg,v,3,'/') || v[1]<1 || v[1]>12 ||
+				   v[2]<RTC_TS_YEAR_MIN || v[2]>RTC_TS_YEAR_MAX ||
+				   v[0]<1 || v[0]>DaysInMonth(v[2],v[1]))
+					return "RANGE";
+				SetRTCDateInfo(v[0],v[1],v[2]);
+			}
+			else if(CmdStrEq(what,"MODE"))
+			{
+				if(CmdStrEq(arg,"ASCII"))
+					LogSetMode(LOG_MODE_ASCII);
+				else if(CmdStrEq(arg,"BIN"))
+					LogSetMode(LOG_MODE_BINARY);
+				else
+					return "RANGE";
+			}
+			else
+				return "?";
+			return 0;
+}
+
+//------------------------------------------------------------
+// Function: CmdTxKeyVal
+// Purpose : Send " key=value"
+//------------------------------------------------------------
+
+static void CmdTxKeyVal(s8 *key,u32 val)
+{
+			UARTTxChar(' ');
+			UARTTxStr(key);
+			UARTTxChar('=');
+			UARTTxU32(val);
+}
+
+//------------------------------------------------------------
+// Function: CmdStats
+// Purpose : GET STATS - one line of counters, one per task and
+//           one per interrupt slot
+// Note    : Worst case with the current tables is 102 + 6 x 65 +
+//           6 x 69 = 906 bytes, far more than the 255 byte transmit
+//           ring; every line first waits for ring space (each line
+//           is checked against the ring size at compile time)
+//------------------------------------------------------------
+
+static void CmdStats(void)
+{
+			UARTTxWait(CMD_STATS_LINE_MAX);
+			UARTTxStr("STATS");
+			CmdTxKeyVal("up",GetRTCTicks());
+			CmdTxKeyVal("txovf",UARTTxOvfCount());
+			CmdTxKeyVal("rxovf",UARTRxOvfCount());
+			CmdTxKeyVal("adcovf",Get_ADCOvfCount());
+			CmdTxKeyVal("adcdrop",Get_ADCDropCount());
+			UARTTxStr("\n\r");
+			SchedReport();
+			VicReport();
+}
+
+//------------------------------------------------------------
+// Function: CmdDump
+// Purpose : DUMP - clock, settings and latest result per channel
+//------------------------------------------------------------
+
+static void CmdDump(void)
+{
+			u32 ts,ch,code,ovs;
+			s32 dow;
+	
+			ts=GetRTCTimestamp();
+			GetRTCDay(&dow);
+			UARTTxStr("TIME ");
+			UARTTxChar(DIG2_TENS(RTC_TS_HOUR(ts)));
+			UARTTxChar(DIG2_ONES(RTC_TS_HOUR(ts)));
+			UARTTxChar(':');
+			UARTTxChar(DIG2_TENS(RTC_TS_MIN(ts)));
+			UARTTxChar(DIG2_ONES(RTC_TS_MIN(ts)));
+			UARTTxChar(':');
+			UARTTxChar(DIG2_TENS(RTC_TS_SEC(ts)));
+			UARTTxChar(DIG2_ONES(RTC_TS_SEC(ts)));
+			UARTTxChar(' ');
+			UARTTxChar(DIG2_TENS(RTC_TS_DATE(ts)));
+			UARTTxChar(DIG2_ONES(RTC_TS_DATE(ts)));
+			UARTTxChar('/');
+			UARTTxChar(DIG2_TENS(RTC_TS_MONTH(ts)));
+			UARTTxChar(DIG2_ONES(RTC_TS_MONTH(ts)));
+			UARTTxChar('/');
+			UARTTxU32(RTC_TS_YEAR(ts));
+			UARTTxChar(' ');
+			UARTTxStr(week[(dow>=0 && dow<7)?dow:0]);
+			UARTTxStr("\n\r");
+	
+			UARTTxStr("CONF");
+			CmdTxKeyVal("sp",setpoint);
+			UARTTxStr((logMode==LOG_MODE_BINARY)?" mode=BIN":" mode=ASCII");
+			CmdTxKeyVal("rate",Get_ADCRate());
+			CmdTxKeyVal("baud",UART_BAUD);
+			UARTTxStr("\n\r");
+	
+			for(ch=0;ch<4;ch++)
+			{
+				if(!Get_ADCLatest(ch,&code,&ovs))
+					continue;
+				UARTTxStr("AIN");
+				UARTTxChar('0'+ch);
+				CmdTxKeyVal("code",code);
+				CmdTxKeyVal("ovs",ovs);
+				UARTTxStr(" temp=");
+				UARTTxMilli(Conv_LM35_mC_OS(ch,code,ovs));
+				UARTTxStr("\n\r");
+			}
+}
+
+//------------------------------------------------------------
+// Function: CmdExec
+// Purpose : Execute one received line
+//------------------------------------------------------------
+
+static void CmdExec(u8 *p)
+{
+			u8 *cmd=CmdTok(&p);
+	
+			if(!*cmd)
+				return;
+			if(CmdStrEq(cmd,"SET"))
+				CmdReply(CmdSet(p));
+			else if(CmdStrEq(cmd,"GET") && CmdStrEq(CmdTok(&p),"STATS"))
+			{
+				CmdStats();
+				CmdReply(0);
+			}
+			else if(CmdStrEq(cmd,"DUMP"))
+			{
+				CmdDump();
+				CmdReply(0);
+			}
+			else
+				CmdReply("?");
+}
+
+//------------------------------------------------------------
+// Function: CmdPoll
+// Purpose : Consume received characters; run complete lines
+// Note    : Never blocks, call once per main loop iteration
+//------------------------------------------------------------
+
+void CmdPoll(void)
+{
+			u8 ch;
+	
+			while(UARTRxGet(&ch))
+			{
+				if(ch=='\r' || ch=='\n')
+				{
+					cmdLine[cmdLen]=0;
+					if(cmdOvf)
+						CmdReply("LONG");
+					else
+						CmdExec(cmdLine);
+					cmdLen=0;
+					cmdOvf=0;
+				}
+				else if(ch=='\b' || ch==0x7F)
+				{
+					if(cmdLen)
+						cmdLen--;
+				}
+				else if(cmdLen<CMD_LINE_MAX-1)
+				{
+					// Keywords are matched in upper case
+					if(ch>='a' && ch<='z')
+						ch-='a'-'A';
+					cmdLine[cmdLen++]=ch;
+				}
+				else
+					cmdOvf=1;
+			}
+}
@@ -0,0 +1,9 @@
+//cmd.h
+#ifndef CMD_H
+#define CMD_H
+
+#include "types.h"
+
+void CmdPoll(void);
+
+#endif
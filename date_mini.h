@@ -0,0 +1,14 @@
+//date.h
+#ifndef DATE_H
+#define DATE_H
+
+#include "types.h"
+
+u32 IsLeapYear(s32 y);
+u32 DaysInMonth(s32 y,u32 m);
+s32 DaysFromCivil(s32 y,u32 m,u32 d);
+void CivilFromDays(s32 z,s32 *y,u32 *m,u32 *d);
+u32 WeekdayFromDays(s32 z);
+u32 DayOfYear(s32 y,u32 m,u32 d);
+
+#endif
@@ -1,23 +1,113 @@
 /*===============================================================
  File: delay.c
- Functions: delay_us,delay_ms,delay_s.
+ Functions: Timebase_Init, Micros, DeadlineSet, DeadlinePassed,
+            delay_us, delay_ms, delay_s.
  Purpose:
-   - Provide simple blocking delay routines for LPC21xx
-   - Implement microsecond, millisecond, and second delays
-   - Useful for timing, debouncing, and sensor read intervals
+   - Provide a monotonic microsecond timebase on Timer1
+     (prescaled from PCLK, free running, wraps every ~71 min)
+   - Non-blocking deadlines that drivers poll instead of spinning
+   - Blocking microsecond, millisecond and second delays timed by
+     the same counter, independent of compiler, optimisation and
+     MAM settings
+ Note: Timer1 MR0 is shared with the keypad scan tick, which only
+       moves MR0 and never resets the counter.
 ===============================================================*/
+
+// Header with LPC21xx register definitions
+#include<LPC21xx.h>
+
+// Header containing project-specific macros, typedefs & prototypes
+#include "Mini_headers.h"
+
+//------------------------------------------------------------
+// Function: Timebase_Init
+// Purpose : Start Timer1 counting microseconds (once; later
+//           calls leave a running counter untouched)
+//------------------------------------------------------------
+
+void Timebase_Init(void)
+{
+	if(READBIT(T1TCR,TCR_EN_BIT))
+		return;
+	
+	// Timer1 TC increments every 1 s
+	T1TCR=1<<TCR_RESET_BIT;
+	T1PR=(PCLK/1000000)-1;
+	T1TCR=1<<TCR_EN_BIT;
+}
+
+//------------------------------------------------------------
+// Function: Micros
+// Purpose : Current timebase count in microseconds
+//------------------------------------------------------------
+
+u32 Micros(void)
+{
+	return T1TC;
+}
+
+//------------------------------------------------------------
+// Function: DeadlineSet
+// Purpose : Deadline us microseconds from now (us < 2^31)
+//------------------------------------------------------------
+
+u32 DeadlineSet(u32 us)
+{
+	return T1TC+us;
+}
+
+//------------------------------------------------------------
+// Function: DeadlinePassed
+// Purpose : 1 once the timebase has reached deadline dl
+// Note    : Wrap safe for deadlines up to 2^31 s (~35 min) away
+//------------------------------------------------------------
+
+u32 DeadlinePassed(u32 dl)
+{
+	return (s32)(T1TC-dl)>=0;
+}
+
+//------------------------------------------------------------
+// Function: delay_us
+// Purpose : Wait at least tdly microseconds (at most tdly+1)
+//------------------------------------------------------------
+
 void delay_us(unsigned int tdly)
 {
-	tdly*=12;
-	while(tdly--);
+	u32 t0;
+	
+	Timebase_Init();
+	t0=T1TC;
+	while((T1TC-t0)<=tdly);
 }
+
+//------------------------------------------------------------
+// Function: delay_ms
+// Purpose : Wait tdly milliseconds
+//------------------------------------------------------------
+
 void delay_ms(unsigned int tdly)
 {
-	tdly*=12000;
-	while(tdly--);
+	u32 dl;
+	
+	Timebase_Init();
+	dl=T1TC+1;
+	
+	// One millisecond step at a time so long delays cannot overflow
+	while(tdly--)
+	{
+		dl+=1000;
+		while(!DeadlinePassed(dl));
+	}
 }
+
+//------------------------------------------------------------
+// Function: delay_s
+// Purpose : Wait tdly seconds
+//------------------------------------------------------------
+
 void delay_s(unsigned int tdly)
 {
-	tdly*=12000000;
-	while(tdly--);
+	while(tdly--)
+		delay_ms(1000);
 }
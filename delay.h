@@ -1,3 +1,8 @@
+#include "types.h"
+void Timebase_Init(void);
+u32 Micros(void);
+u32 DeadlineSet(u32);
+u32 DeadlinePassed(u32);
 void delay_us(unsigned int);
 void delay_ms(unsigned int);
 void delay_s(unsigned int);
@@ -0,0 +1,69 @@
+/*===============================================================
+File: digits.c
+Purpose: Decimal formatting shared by the RTC, LCD and UART
+output functions. ARM7TDMI has no divide instruction, so every
+/10 or %10 is a library call; here digits are produced two at a
+time from a const "00".."99" table and the quotients come from
+reciprocal multiplies (DIVxx in digits_mini.h), so no division
+is performed at all.
+===============================================================*/
+
+//Only needs its own header, so host/digits_bench.c can build it too
+#include "digits_mini.h"
+
+//---------------------------------------------------------
+// Two-digit table, entry v at digits2[2*v]
+//---------------------------------------------------------
+
+const u8 digits2[201]=
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+//------------------------------------------------------------
+// Function: FmtU32
+// Purpose : Convert unsigned integer to NUL terminated decimal
+// Arguments:
+// buf   - Output buffer, at least 11 bytes
+// num   - Value to convert
+// width - Minimum digits, left padded with '0' (0 or 1 = none)
+// Return : Number of characters written (without NUL)
+//------------------------------------------------------------
+
+u32 FmtU32(u8 *buf,u32 num,u32 width)
+{
+			u8 tmp[10];
+			u32 i=10,n=0,q,r;
+	
+			// Two digits per step from the low end
+			while(num>=100)
+			{
+				q=DIV100(num);
+				r=num-q*100;
+				tmp[--i]=DIG2_ONES(r);
+				tmp[--i]=DIG2_TENS(r);
+				num=q;
+			}
+			if(num>=10)
+			{
+				tmp[--i]=DIG2_ONES(num);
+				tmp[--i]=DIG2_TENS(num);
+			}
+			else
+				tmp[--i]='0'+num;
+	
+			while((10-i)<width && i>0)
+				tmp[--i]='0';
+	
+			while(i<10)
+				buf[n++]=tmp[i++];
+			buf[n]=0;
+			return n;
+}
@@ -0,0 +1,19 @@
+//digits.h
+#ifndef DIGITS_H
+#define DIGITS_H
+
+#include "types.h"
+
+//"00"  "99" : two ASCII digits per entry
+extern const u8 digits2[201];
+#define DIG2_TENS(v) (digits2[2*(v)])	//v < 100
+#define DIG2_ONES(v) (digits2[2*(v)+1])
+
+//Unsigned division by constants as multiply-high (exact for all u32)
+#define DIV10(n)   ((u32)(((u64)(u32)(n)*0xCCCCCCCDULL)>>35))
+#define DIV100(n)  ((u32)(((u64)(u32)(n)*0x51EB851FULL)>>37))
+#define DIV1000(n) ((u32)(((u64)(u32)(n)*0x10624DD3ULL)>>38))
+
+u32 FmtU32(u8 *buf,u32 num,u32 width);
+
+#endif
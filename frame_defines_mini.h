@@ -0,0 +1,46 @@
+#ifndef FRAME_DEFINES_H
+#define FRAME_DEFINES_H
+
+//CRC-16/CCITT-FALSE start value
+#define CRC16_INIT 0xFFFF
+
+//COBS frame delimiter
+#define FRAME_DELIM 0x00
+
+//Largest payload FrameSend accepts (keeps COBS to one block and
+//the encode buffers on the stack small)
+#define FRAME_MAX_PAYLOAD 120
+
+//Payload type byte (first byte of every frame)
+#define FRAME_TYPE_LOG 0x01
+
+//FRAME_TYPE_LOG payload, little endian, 11 bytes before CRC
+//  0    type
+//  1-2  sequence number
+//  3-6  packed RTC timestamp (RTC_TS_xxx)
+//  7-8  bits 9-0 millisecond, 11-10 channel, 15-12 flags
+//  9-10 temperature, signed 0.01 C
+//On the wire : +2 CRC, +1 COBS, +1 delimiter = 15 bytes
+#define FRAME_LOG_LEN 11
+#define FRAME_LOG_CH_SHIFT   10
+#define FRAME_LOG_FLAG_SHIFT 12
+#define FRAME_LOG_FLAG_ALERT (1<<0)
+
+#define FRAME_TYPE_BATCH 0x02
+
+//FRAME_TYPE_BATCH payload, little endian
+//  0     type
+//  1-2   batch sequence number
+//  3-6   packed RTC timestamp of first sample
+//  7-8   bits 9-0 millisecond of first sample, 11-10 channel,
+//        13-12 oversampling bits
+//  9-10  sample rate Hz (sample i is at first + i/rate s)
+//  11    sample count
+//  12-13 first ADC code
+//  14-   count-1 code deltas, zig-zag then varint (7 bits per byte,
+//        bit 7 set = more bytes follow)
+#define FRAME_BATCH_HDR_LEN 14
+#define FRAME_BATCH_OVS_SHIFT 12
+#define FRAME_VARINT_MAX 3		//Bytes for one delta of a 13-bit code
+
+#endif
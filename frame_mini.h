@@ -0,0 +1,11 @@
+//frame.h
+#ifndef FRAME_H
+#define FRAME_H
+
+#include "types.h"
+
+u16 Crc16(const u8 *buf,u32 len,u16 crc);
+u32 CobsEncode(const u8 *src,u32 len,u8 *dst);
+u32 FrameSend(const u8 *payload,u32 len);
+
+#endif
@@ -0,0 +1,125 @@
+/*===============================================================
+File: civil_date_test.c
+Purpose: Host test for civil_date.c
+- IsLeapYear on fixed cases (2000, 2100, 1900, 2024, 2023) and
+  against the Gregorian rule
+- Every day from 1900-01-01 through 2199-12-31 (covering the RTC
+  range 2000-2063 and 1970-2099) against libc timegm/gmtime:
+  DaysFromCivil, CivilFromDays, WeekdayFromDays, DayOfYear and
+  DaysInMonth
+- DaysFromCivil/CivilFromDays round trip and day continuity for
+  years -10000 … 10000
+Build  : cc -O2 -I. -o civil_date_test host/civil_date_test.c civil_date.c
+         (from the repository root; runs on the host, not the target)
+===============================================================*/
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <time.h>
+
+#include "date_mini.h"
+
+static u32 fails;
+
+static void Check(int ok,const char *what,long y,long m,long d)
+{
+			if(!ok && fails++<10)
+				printf("FAIL %s %04ld-%02ld-%02ld\n",what,y,m,d);
+}
+
+//------------------------------------------------------------
+// Leap years: fixed cases and the rule for years 1 … 9999
+//------------------------------------------------------------
+
+static void CheckLeap(void)
+{
+			s32 y;
+
+			Check(IsLeapYear(2000)==1,"leap",2000,0,0);
+			Check(IsLeapYear(2100)==0,"leap",2100,0,0);
+			Check(IsLeapYear(1900)==0,"leap",1900,0,0);
+			Check(IsLeapYear(2024)==1,"leap",2024,0,0);
+			Check(IsLeapYear(2023)==0,"leap",2023,0,0);
+			for(y=1;y<10000;y++)
+				Check(IsLeapYear(y)==((y%4==0 && y%100!=0) || y%400==0),"leap",y,0,0);
+}
+
+//------------------------------------------------------------
+// Every day of 1900 … 2199 against timegm/gmtime
+//------------------------------------------------------------
+
+static void CheckAgainstLibc(void)
+{
+			struct tm tm={0},*g;
+			time_t t;
+			s32 z,y,yy;
+			u32 m,d,mm,dd;
+
+			for(y=1900;y<2200;y++)
+			{
+				for(m=1;m<=12;m++)
+				{
+					// One past the month end must not be a valid day
+					tm.tm_year=y-1900;
+					tm.tm_mon=m-1;
+					tm.tm_mday=DaysInMonth(y,m)+1;
+					tm.tm_hour=12;
+					t=timegm(&tm);
+					g=gmtime(&t);
+					Check(g->tm_mday==1 && g->tm_mon!=(int)(m-1),"DaysInMonth",y,m,0);
+
+					for(d=1;d<=DaysInMonth(y,m);d++)
+					{
+						tm.tm_year=y-1900;
+						tm.tm_mon=m-1;
+						tm.tm_mday=d;
+						tm.tm_hour=0;
+						t=timegm(&tm);
+						g=gmtime(&t);
+
+						z=DaysFromCivil(y,m,d);
+						Check(g->tm_mday==(int)d && g->tm_mon==(int)(m-1),"DaysInMonth",y,m,d);
+						Check((long long)z*86400==(long long)t,"DaysFromCivil",y,m,d);
+						Check(WeekdayFromDays(z)==(u32)g->tm_wday,"WeekdayFromDays",y,m,d);
+						Check(DayOfYear(y,m,d)==(u32)g->tm_yday+1,"DayOfYear",y,m,d);
+
+						CivilFromDays(z,&yy,&mm,&dd);
+						Check(yy==y && mm==m && dd==d,"CivilFromDays",y,m,d);
+					}
+				}
+			}
+}
+
+//------------------------------------------------------------
+// Round trip and continuity far outside the libc range
+//------------------------------------------------------------
+
+static void CheckRoundTrip(void)
+{
+			s32 z,zEnd,y,py=0;
+			u32 m,d,pm=0,pd=0;
+
+			z=DaysFromCivil(-10000,1,1);
+			zEnd=DaysFromCivil(10000,12,31);
+			for(;z<=zEnd;z++)
+			{
+				CivilFromDays(z,&y,&m,&d);
+				Check(DaysFromCivil(y,m,d)==z,"round trip",y,m,d);
+				Check(m>=1 && m<=12 && d>=1 && d<=DaysInMonth(y,m),"range",y,m,d);
+				// Next day of the previous date
+				if(pd)
+					Check((d==pd+1 && m==pm && y==py) ||
+					      (d==1 && pd==DaysInMonth(py,pm) &&
+					       ((m==pm+1 && y==py) || (m==1 && pm==12 && y==py+1))),"continuity",y,m,d);
+				py=y; pm=m; pd=d;
+			}
+}
+
+int main(void)
+{
+			CheckLeap();
+			CheckAgainstLibc();
+			CheckRoundTrip();
+			printf("civil_date: %s\n",fails ? "FAILED" : "all checks passed");
+			return fails!=0;
+}
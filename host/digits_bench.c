@@ -0,0 +1,207 @@
+/*===============================================================
+File: digits_bench.c
+Purpose: Host check and micro-benchmark for digits.c
+- DIV10/DIV100/DIV1000 against native division
+- FmtU32 against snprintf, with and without zero padding
+- Division calls per formatted value for the formatters as they
+  were before digits.c (every / and % on ARM7TDMI is a call to
+  __aeabi_uidiv / __aeabi_uidivmod) and as they are now, counted
+  by routing each division through one counting helper
+Build  : cc -O2 -I. -o digits_bench host/digits_bench.c digits.c
+         (from the repository root; runs on the host, not the target)
+===============================================================*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "digits_mini.h"
+
+//---------------------------------------------------------
+// Division counter standing in for __aeabi_uidiv
+//---------------------------------------------------------
+
+static unsigned long divCalls;
+
+static u32 UDiv(u32 a,u32 b) { divCalls++; return a/b; }
+static u32 UMod(u32 a,u32 b) { divCalls++; return a%b; }
+
+static u32 fails;
+
+static void Check(int ok,const char *what,u32 v)
+{
+			if(!ok && fails++<10)
+				printf("FAIL %s %lu\n",what,(unsigned long)v);
+}
+
+//------------------------------------------------------------
+// Old formatters (before digits.c), output into a buffer
+//------------------------------------------------------------
+
+static u32 OldU32(u8 *buf,u32 num)
+{
+			u8 a[10];
+			s32 i=0;
+			u32 n=0;
+
+			if(num==0)
+				buf[n++]='0';
+			while(num>0)
+			{
+				a[i++]=UMod(num,10)+48;
+				num=UDiv(num,10);
+			}
+			for(--i;i>=0;i--)
+				buf[n++]=a[i];
+			buf[n]=0;
+			return n;
+}
+
+static void OldTime(u8 *b,u32 h,u32 m,u32 s)
+{
+			b[0]=UDiv(h,10)+48; b[1]=UMod(h,10)+48; b[2]=':';
+			b[3]=UDiv(m,10)+48; b[4]=UMod(m,10)+48; b[5]=':';
+			b[6]=UDiv(s,10)+48; b[7]=UMod(s,10)+48; b[8]=0;
+}
+
+static void OldDate(u8 *b,u32 d,u32 mo,u32 y)
+{
+			b[0]=UDiv(d,10)+48; b[1]=UMod(d,10)+48; b[2]='/';
+			b[3]=UDiv(mo,10)+48; b[4]=UMod(mo,10)+48; b[5]='/';
+			b[6]=UMod(UDiv(y,1000),10)+48;
+			b[7]=UMod(UDiv(y,100),10)+48;
+			b[8]=UMod(UDiv(y,10),10)+48;
+			b[9]=UMod(y,10)+48; b[10]=0;
+}
+
+static void OldMilli(u8 *b,u32 num)
+{
+			u32 n=OldU32(b,UDiv(num,1000)),frac=UMod(num,1000);
+
+			b[n++]='.';
+			b[n++]=UDiv(frac,100)+48;
+			b[n++]=UMod(UDiv(frac,10),10)+48;
+			b[n++]=UMod(frac,10)+48;
+			b[n]=0;
+}
+
+//------------------------------------------------------------
+// Current formatters, as in RTC.c / lcd.c / uart.c
+//------------------------------------------------------------
+
+static void NewTime(u8 *b,u32 h,u32 m,u32 s)
+{
+			b[0]=DIG2_TENS(h); b[1]=DIG2_ONES(h); b[2]=':';
+			b[3]=DIG2_TENS(m); b[4]=DIG2_ONES(m); b[5]=':';
+			b[6]=DIG2_TENS(s); b[7]=DIG2_ONES(s); b[8]=0;
+}
+
+static void NewDate(u8 *b,u32 d,u32 mo,u32 y)
+{
+			b[0]=DIG2_TENS(d); b[1]=DIG2_ONES(d); b[2]='/';
+			b[3]=DIG2_TENS(mo); b[4]=DIG2_ONES(mo); b[5]='/';
+			FmtU32(b+6,y,1);
+}
+
+static void NewMilli(u8 *b,u32 num)
+{
+			u32 whole=DIV1000(num);
+			u32 n=FmtU32(b,whole,1);
+
+			b[n++]='.';
+			FmtU32(b+n,num-whole*1000,3);
+}
+
+//------------------------------------------------------------
+// Correctness against native division and snprintf
+//------------------------------------------------------------
+
+static void CheckValue(u32 v)
+{
+			char ref[32];
+			u8 out[16];
+
+			Check(DIV10(v)==v/10,"DIV10",v);
+			Check(DIV100(v)==v/100,"DIV100",v);
+			Check(DIV1000(v)==v/1000,"DIV1000",v);
+
+			snprintf(ref,sizeof ref,"%lu",(unsigned long)v);
+			Check(FmtU32(out,v,1)==strlen(ref) && !strcmp((char*)out,ref),"FmtU32",v);
+			snprintf(ref,sizeof ref,"%06lu",(unsigned long)v);
+			Check(FmtU32(out,v,6)==strlen(ref) && !strcmp((char*)out,ref),"FmtU32 w6",v);
+}
+
+static void CheckAll(void)
+{
+			u32 v,p;
+
+			for(v=0;v<1000000;v++)
+				CheckValue(v);
+			// Powers of ten and their neighbours, then a stride to 2^32-1
+			for(p=10;p<=1000000000UL;p*=10)
+			{
+				CheckValue(p-1);
+				CheckValue(p);
+				CheckValue(p+1);
+			}
+			for(v=1000000;v<0xFFFFFFFFUL-9973;v+=9973)
+				CheckValue(v);
+			CheckValue(0xFFFFFFFFUL);
+}
+
+//------------------------------------------------------------
+// One formatting pass as done every second on the target:
+// LCD time, LCD date, UART temperature and a counter value
+//------------------------------------------------------------
+
+#define BENCH_N 2000000UL
+
+static double Pass(int useNew,unsigned long *calls)
+{
+			u8 b[32];
+			u32 i,sink=0;
+			clock_t t0;
+
+			divCalls=0;
+			t0=clock();
+			for(i=0;i<BENCH_N;i++)
+			{
+				u32 s=i%60,m=(i/60)%60,h=(i/3600)%24;
+				if(useNew)
+				{
+					NewTime(b,h,m,s);	sink+=b[7];
+					NewDate(b,1+i%28,1+i%12,2000+i%64);	sink+=b[9];
+					NewMilli(b,i%150000);	sink+=b[0];
+					FmtU32(b,i,1);	sink+=b[0];
+				}
+				else
+				{
+					OldTime(b,h,m,s);	sink+=b[7];
+					OldDate(b,1+i%28,1+i%12,2000+i%64);	sink+=b[9];
+					OldMilli(b,i%150000);	sink+=b[0];
+					OldU32(b,i);	sink+=b[0];
+				}
+			}
+			*calls=divCalls;
+			if(sink==1)
+				printf(" ");
+			return (double)(clock()-t0)*1e9/CLOCKS_PER_SEC/BENCH_N;
+}
+
+int main(void)
+{
+			unsigned long oldCalls,newCalls;
+			double oldNs,newNs;
+
+			CheckAll();
+			printf("check : %s\n",fails ? "FAILED" : "DIVxx and FmtU32 match native");
+
+			oldNs=Pass(0,&oldCalls);
+			newNs=Pass(1,&newCalls);
+			printf("old   : %5.2f divisions/pass  %6.1f ns/pass\n",(double)oldCalls/BENCH_N,oldNs);
+			printf("new   : %5.2f divisions/pass  %6.1f ns/pass\n",(double)newCalls/BENCH_N,newNs);
+			printf("(pass = time + date + temperature + counter. The host divides\n"
+			       " in hardware, so ns/pass is not representative of ARM7TDMI,\n"
+			       " where each division is a __aeabi_uidiv library call)\n");
+			return fails!=0;
+}
@@ -2,4 +2,6 @@
 void KeyPdInit(void);
 u8 ColStat(void);
 u8 KeyVal(void);
+u8 GetKeyEvent(void);
+int GetKeyPress(void);
 
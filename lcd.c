@@ -8,6 +8,8 @@ LCD pin mapping:
 - RW          : P0.11
 - EN          : P0.12
 Provides functions for LCD command, character, integer, and string display.
+A 2x16 shadow frame buffer lets periodic screens be rendered into RAM
+and flushed, so only the characters that changed are sent to the LCD.
 ------------------------------------------------------------*/
 
 // Header with LPC21xx register definitions
@@ -16,6 +18,69 @@ Provides functions for LCD command, character, integer, and string display.
 // Header containing project-specific macros, typedefs & prototypes
 #include "Mini_headers.h"
 
+//---------------------------------------------------------
+// Shadow frame buffer
+// lcdFb    : characters the application wants on screen
+// lcdPanel : characters currently shown on the LCD glass
+// lcdAddr  : LCD DDRAM address counter (LCD_ADDR_UNKNOWN if
+//            not tracked, e.g. after a cursor shift/CGRAM access)
+// lcdFbPos : write position (0-31) for Fb*LCD functions
+//---------------------------------------------------------
+
+u8 lcdFb[LCD_ROWS*LCD_COLS];
+u8 lcdPanel[LCD_ROWS*LCD_COLS];
+u8 lcdAddr=LCD_ADDR_UNKNOWN;
+u8 lcdFbPos=0;
+
+#ifdef LCD_BUSY_POLL
+//---------------------------------------------------------
+// lcdBusyPoll : 1 -> wait on HD44780 busy flag after each write
+//               0 -> fixed delays (during power-on sequence or
+//               after a busy-flag timeout)
+//---------------------------------------------------------
+
+u8 lcdBusyPoll=0;
+#endif
+
+//------------------------------------------------------------
+// Function: LCDAddrToCell
+// Purpose : Map DDRAM address to frame buffer cell index
+// Return  : 0-31 for visible cells, LCD_CELLS if off-screen
+//------------------------------------------------------------
+
+static u8 LCDAddrToCell(u8 addr)
+{
+	if((addr&0x3F)>=LCD_COLS)
+		return LCD_CELLS;
+	return (((addr>>6)&1)*LCD_COLS)+(addr&0x0F);
+}
+
+//------------------------------------------------------------
+// Function: LCDCellToAddr
+// Purpose : Map frame buffer cell index to DDRAM address
+//------------------------------------------------------------
+
+static u8 LCDCellToAddr(u8 cell)
+{
+	return ((cell/LCD_COLS)<<6)|(cell%LCD_COLS);
+}
+
+//------------------------------------------------------------
+// Function: LCDFbReset
+// Purpose : Mark frame buffer and panel copy as blank
+//------------------------------------------------------------
+
+static void LCDFbReset(void)
+{
+	u8 i;
+	for(i=0;i<LCD_CELLS;i++)
+	{
+		lcdFb[i]=' ';
+		lcdPanel[i]=' ';
+	}
+	lcdFbPos=0;
+}
+
 //------------------------------------------------------------
 // Function: InitLCD
 // Purpose : Configure GPIO pins for LCD and initialize in 8-bit mode
@@ -40,6 +105,11 @@ void InitLCD(void)
 			// Function set: 8-bit mode, 2 lines, 5x7 font
 			CmdLCD(0x38);
 	
+			#ifdef LCD_BUSY_POLL
+			// Busy flag is valid from here on
+			lcdBusyPoll = 1;
+			#endif
+	
 			// Move cursor or display shift command
 			CmdLCD(0x10);
 			
@@ -65,6 +135,19 @@ void CmdLCD(u8 cmd)
 	// Clear RS pin (P0.10 ? Command mode)
 	IOCLR0 = 1 << RS;  // RS = P0.10
 	DispLCD(cmd);
+	
+	// Keep shadow copy in step with commands that move the cursor
+	if(cmd & 0x80)
+		lcdAddr = cmd & 0x7F;		// Set DDRAM address
+	else if(cmd == 0x01)
+	{
+		LCDFbReset();							// Clear display
+		lcdAddr = 0;
+	}
+	else if((cmd & 0xFE) == 0x02)
+		lcdAddr = 0;							// Return home
+	else if(((cmd & 0xF0) == 0x10) || ((cmd & 0xC0) == 0x40))
+		lcdAddr = LCD_ADDR_UNKNOWN;	// Cursor shift / CGRAM address
 }
 
 //------------------------------------------------------------
@@ -75,16 +158,69 @@ void CmdLCD(u8 cmd)
 
 void CharLCD(u8 dat)
 {
+	u8 cell;
+	
 	// Set RS pin (P0.10 ? Data mode)
 	IOSET0 = 1 << RS;  // RS = P0.10
 	DispLCD(dat);
+	
+	// Direct writes go to both panel copy and frame buffer
+	if(lcdAddr != LCD_ADDR_UNKNOWN)
+	{
+		cell = LCDAddrToCell(lcdAddr);
+		if(cell < LCD_CELLS)
+		{
+			lcdPanel[cell] = dat;
+			lcdFb[cell] = dat;
+		}
+		lcdAddr++;
+	}
 }
 
+#ifdef LCD_BUSY_POLL
+//------------------------------------------------------------
+// Function: LCDWaitReady
+// Purpose : Poll HD44780 busy flag (DB7 on P0.9) until clear
+// Method  : Data lines switched to input, RS = 0, RW = 1 and
+//           EN pulsed for each read; lines restored afterwards
+// Return  : 1 ? LCD ready, 0 ? still busy after LCD_BUSY_TIMEOUT_US
+//------------------------------------------------------------
+
+static u8 LCDWaitReady(void)
+{
+	u32 dl = DeadlineSet(LCD_BUSY_TIMEOUT_US);
+	u32 busy;
+	
+	// Release data lines and select busy flag/address read
+	IODIR0 &= ~(LCD_DAT << 2);
+	IOCLR0 = 1 << RS;
+	IOSET0 = 1 << RW;
+	
+	do
+	{
+		IOSET0 = 1 << EN;
+		delay_us(1);
+		busy = READBIT(IOPIN0, LCD_BF_PIN);
+		IOCLR0 = 1 << EN;
+		delay_us(1);
+	}while(busy && !DeadlinePassed(dl));
+	
+	// Back to write mode with data lines driven
+	IOCLR0 = 1 << RW;
+	IODIR0 |= (LCD_DAT << 2);
+	
+	return (busy == 0);
+}
+#endif
+
 //------------------------------------------------------------
 // Function: DispLCD
 // Purpose : Common display routine to write 8-bit value to LCD
 // Pins    : RW = 0, EN pulse generated
 // Argument: val ? 8-bit value (command or data)
+// Note    : With LCD_BUSY_POLL the busy flag is polled instead of
+//           the fixed 2 ms + 5 ms delays. A timeout falls back to
+//           the fixed delays for all further writes.
 //------------------------------------------------------------
 
 void DispLCD(u8 val)
@@ -95,6 +231,23 @@ void DispLCD(u8 val)
 	// Write byte to data pins using WRITEBYTE macro (kept as-is)
 	WRITEBYTE(IOPIN0, 2, val); 
 
+	#ifdef LCD_BUSY_POLL
+	if(lcdBusyPoll)
+	{
+		// Short enable pulse (P0.12), then wait for busy flag
+		IOSET0 = 1 << EN;
+		delay_us(1);
+		IOCLR0 = 1 << EN;
+		
+		if(!LCDWaitReady())
+		{
+			lcdBusyPoll = 0;
+			delay_ms(5);
+		}
+		return;
+	}
+	#endif
+
 	// Generate enable pulse (P0.12)
 	IOSET0 = 1 << EN; // EN = P0.12
 	delay_ms(2);
@@ -123,43 +276,92 @@ void StrLCD(u8 *ptr)
 
 void IntLCD(s32 num)
 {
-	u8 a[10];
-	s8 i=0;
-	//itoa
-	if(num==0)
-		CharLCD('0');
-	else
+	u8 a[11];
+	
+	if(num<0)
 	{
-		if(num<0)
-		{
-			num=-num;
-			CharLCD('-');
-		}
-		while(num>0)
-		{
-			a[i++]=num%10+48;
-			num=num/10;
-		}
-		for(--i;i>=0;i--)
-			CharLCD(a[i]);
+		num=-num;
+		CharLCD('-');
 	}
+	FmtU32(a,num,1);
+	StrLCD(a);
 }
 
 //------------------------------------------------------------
 // Function: DisplayTemp
-// Purpose : Display 2-digit temperature value on LCD at position 0x8C
-// Argument: temp ? Unsigned temperature integer
+// Purpose : Render 2-digit temperature value into frame buffer at 0x8C
+// Argument: temp ? Unsigned temperature integer (shown as 99 above 99)
 //------------------------------------------------------------
 
 void DisplayTemp(u32 temp)
 {
-		// Set DDRAM address to 0x8C (2nd line temperature position)
-		CmdLCD(0x8c);
+		// Set frame buffer position to 0x8C (temperature position)
+		FbGotoLCD(0x8c);
+	
+		if(temp>99)
+			temp=99;
 	
 		 // Print tens and ones digit
-		CharLCD((temp/10)+48);
-		CharLCD((temp%10)+48);
+		FbCharLCD(DIG2_TENS(temp));
+		FbCharLCD(DIG2_ONES(temp));
 	
 }
 
+//------------------------------------------------------------
+// Function: FbGotoLCD
+// Purpose : Set frame buffer write position
+// Argument: addr ? Set-DDRAM command as used with CmdLCD
+//           (0x80-0x8F 1st line, 0xC0-0xCF 2nd line)
+//------------------------------------------------------------
+
+void FbGotoLCD(u8 addr)
+{
+	lcdFbPos = LCDAddrToCell(addr & 0x7F);
+}
+
+//------------------------------------------------------------
+// Function: FbCharLCD
+// Purpose : Write a character into the frame buffer only
+// Argument: dat ? 8-bit character data
+//------------------------------------------------------------
+
+void FbCharLCD(u8 dat)
+{
+	if(lcdFbPos < LCD_CELLS)
+		lcdFb[lcdFbPos++] = dat;
+}
+
+//------------------------------------------------------------
+// Function: FbStrLCD
+// Purpose : Write null-terminated string into the frame buffer
+// Argument: ptr ? Pointer to input string buffer
+//------------------------------------------------------------
 
+void FbStrLCD(u8 *ptr)
+{
+	while(*ptr)
+		FbCharLCD(*ptr++);
+}
+
+//------------------------------------------------------------
+// Function: FlushLCD
+// Purpose : Send only the cells that differ from the panel.
+//           A cursor command is issued only when the next dirty
+//           cell is not where the LCD address counter already is.
+//------------------------------------------------------------
+
+void FlushLCD(void)
+{
+	u8 i,addr;
+	
+	for(i=0;i<LCD_CELLS;i++)
+	{
+		if(lcdFb[i] == lcdPanel[i])
+			continue;
+		
+		addr = LCDCellToAddr(i);
+		if(lcdAddr != addr)
+			CmdLCD(0x80 | addr);
+		CharLCD(lcdFb[i]);
+	}
+}
@@ -7,6 +7,10 @@ void StrLCD(u8 *);
 void IntLCD(s32);
 void FltLCD(f32);
 void StoreCustCharFont(void);
+void FbGotoLCD(u8);
+void FbCharLCD(u8);
+void FbStrLCD(u8 *);
+void FlushLCD(void);
 	
 	
 
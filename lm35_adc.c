@@ -4,6 +4,20 @@ Purpose: Configure ADC of the LPC21xx ARM7 MCU to read LM35 temperature
 sensor using single channel (CH1) and differential channels (CH1).
 Returns temperature in C or F without clearing UART/LCD for 1 minute
 in normal operation case.
+Timer0 match interrupt paces conversions at a fixed rate; each result
+is pushed with its millisecond RTC timestamp into a single-producer/single-consumer
+ring which the main loop drains.
+Optional per-channel oversampling: each Timer0 tick starts a burst of
+4^n back-to-back conversions collected by the ADC DONE interrupt, which
+are summed and decimated to 10+n bits.
+Burst-scan mode: the ADC converts a channel mask (AIN0 - AIN3)
+continuously in hardware BURST mode; the DONE interrupt latches each
+channel's latest (decimated) result with a sequence counter, and the
+Timer0 tick snapshots those values into the sample ring.
+Over-temperature comparator: the alert setpoint is converted once
+to raw code thresholds, and the DONE interrupt compares every
+finished result against them, switching the status LED and the
+alert flag in the interrupt that produced the sample.
 ===============================================================*/
 
 //Header with LPC21xx register definitions
@@ -23,6 +37,70 @@ u32 adcChSel[4]={AIN0_PIN_0_27,
                  AIN3_PIN_0_30
                 };
 
+//---------------------------------------------------------
+// Build-time LM35 lookup tables (lm35_lut.c)
+//---------------------------------------------------------
+
+extern const s32 lm35LutC[4][ADC_LUT_SIZE];
+extern const s32 lm35LutF[4][ADC_LUT_SIZE];
+
+//---------------------------------------------------------
+// Timer0 paced sample ring
+// adcRingHead : written only by ADC_ISR (producer)
+// adcRingTail : written only by Get_ADCSample (consumer)
+//---------------------------------------------------------
+
+ADCSample adcRing[ADC_RING_SIZE];
+volatile u32 adcRingHead=0,adcRingTail=0;
+volatile u32 adcRingOvfCnt=0;		// Samples dropped because ring was full
+u32 adcSmpCh;										// Channel being sampled
+u32 adcPendTs;									// Timestamp of sample in progress
+u16 adcPendMs;									// Millisecond of adcPendTs
+volatile u32 adcBusy=0;					// 1 -> oversampling burst in progress
+u32 adcRateHz;									// Sampler rate set by Start_ADCSampler
+volatile u32 adcSkipCnt=0;			// Ticks skipped because burst still running
+
+//---------------------------------------------------------
+// Oversampling : extra bits n per channel (4^n conversions)
+//---------------------------------------------------------
+
+u8 adcOvsBits[4]={ADC_OVS_BITS_CH0,
+                  ADC_OVS_BITS_CH1,
+                  ADC_OVS_BITS_CH2,
+                  ADC_OVS_BITS_CH3
+                 };
+u32 adcAcc;											// Sum of conversions in current burst
+u32 adcAccCnt;									// Conversions collected so far
+u32 adcAccBits;									// Extra bits n of current burst
+
+//---------------------------------------------------------
+// Burst-scan mode : latest result per channel
+// adcLatest/adcLatestOvs/adcSeq written only by ADC_ISR
+//---------------------------------------------------------
+
+u32 adcScanMask=0;							// Channels scanned, 0 -> single channel mode
+volatile u16 adcLatest[4];			// Latest decimated result per channel
+volatile u8 adcLatestOvs[4];		// Extra bits of adcLatest
+volatile u32 adcSeq[4];					// Results latched per channel
+u32 adcSeqSent[4];							// adcSeq value last pushed into ring
+u32 adcChAcc[4];								// Oversampling sum per channel
+u32 adcChCnt[4];								// Conversions in adcChAcc
+u8 adcChBits[4];								// Extra bits n of adcChAcc, latched at its start
+
+//---------------------------------------------------------
+// Over-temperature comparator (codes at ADC_OVS_BITS_MAX bits)
+// code >= adcAlertTrip -> alert on, code < adcAlertClr -> off,
+// in between (exactly at setpoint) the state is kept
+//---------------------------------------------------------
+
+volatile u32 adcAlertCh=ADC_ALERT_OFF;	// Channel compared
+volatile u32 adcAlertTrip;			// First code above setpoint
+volatile u32 adcAlertClr;				// First code not below setpoint
+volatile u32 adcAlert=0;				// 1 -> over setpoint, LED on
+
+void Timer0_ISR(void) __irq;
+void ADC_ISR(void) __irq;
+
 //------------------------------------------------------------
 // Function: Init_ADC
 // Purpose : Initialize ADC for selected channel on AIN pins
@@ -48,16 +126,16 @@ void Init_ADC(u32 chNo)
 }
 
 //------------------------------------------------------------
-// Function: Read_ADC
+// Function: Read_ADCVal
 // Purpose : Start ADC conversion, wait for completion & read digital value
-// Arguments: 
-// chNo     - ADC channel number
-// eAR      - Pointer to store converted analog result (voltage)
-// adcDVal  - Pointer to store 10-bit ADC digital value
+// Argument: chNo - ADC channel number
+// Return  : 10-bit ADC digital value (integer only, no float math)
 //------------------------------------------------------------
 
-void Read_ADC(u32 chNo,f32 *eAR,u32 *adcDVal)
+u32 Read_ADCVal(u32 chNo)
 {
+			u32 dl;
+	
 			// Clear previous channel selection bits
 			ADCR&=0xFFFFFF00;
 	
@@ -67,14 +145,31 @@ void Read_ADC(u32 chNo,f32 *eAR,u32 *adcDVal)
 			// Wait small time for ADC sampling
 			delay_us(3);
 	
-			// Wait until conversion is completed (DONE bit becomes 1)
-			while(((ADDR>>DONE_BIT)&1)==0);
+			// Wait until conversion is completed (DONE bit becomes 1),
+			// bounded so a stalled ADC cannot hang the caller
+			dl=DeadlineSet(ADC_CONV_TIMEOUT_US);
+			while(((ADDR>>DONE_BIT)&1)==0 && !DeadlinePassed(dl));
 	
 			// Stop ADC conversion
 			ADCR&=~(1<<ADC_CONV_START_BIT);
 	
 			// Read 10-bit digital data from ADC result register
-			*adcDVal=((ADDR>>DIGITAL_DATA_BITS)&1023);
+			return ((ADDR>>DIGITAL_DATA_BITS)&1023);
+}
+
+//------------------------------------------------------------
+// Function: Read_ADC
+// Purpose : Start ADC conversion, wait for completion & read digital value
+// Arguments: 
+// chNo     - ADC channel number
+// eAR      - Pointer to store converted analog result (voltage)
+// adcDVal  - Pointer to store 10-bit ADC digital value
+// Note     : Float compatibility wrapper around Read_ADCVal()
+//------------------------------------------------------------
+
+void Read_ADC(u32 chNo,f32 *eAR,u32 *adcDVal)
+{
+			*adcDVal=Read_ADCVal(chNo);
 			
 			// Convert digital value into equivalent analog voltage (03.3V)
 			*eAR=*adcDVal * (3.3/1023);
@@ -85,20 +180,499 @@ void Read_ADC(u32 chNo,f32 *eAR,u32 *adcDVal)
 // Purpose : Read LM35 temperature using differential ADC channels (CH1)
 // Argument: tType - 'C' for Celsius, 'F' for Fahrenheit
 // Return  : Temperature in selected format
+// Note    : Float compatibility wrapper around Read_LM35_mDeg()
 //------------------------------------------------------------
 
 f32 Read_LM35_NP(u8 tType)
 {
-			u32 adcDVal1; 
-			f32 eAR1,tDeg;
-			
-			// Read ADC values from channel  1
-			Read_ADC(CH1,&eAR1,&adcDVal1);
-		
+			// Read ADC value from channel 1 & convert via calibrated table
+			return Read_LM35_mDeg(tType)*0.001f;
+}
+
+//------------------------------------------------------------
+// Function: Read_LM35_mDeg
+// Purpose : Integer LM35 temperature read (no soft-float calls)
+// Argument: tType - 'C' for Celsius, 'F' for Fahrenheit
+// Return  : Temperature in millidegrees of selected format
+//------------------------------------------------------------
+
+s32 Read_LM35_mDeg(u8 tType)
+{
+			// Read ADC value from channel 1 and convert via lookup table
+			return Conv_LM35_mDeg(CH1,Read_ADCVal(CH1),tType);
+}
+
+//------------------------------------------------------------
+// Function: ADCInstallISR
+// Purpose : Install ADC DONE ISR in its VIC vectored slot
+//------------------------------------------------------------
+
+static void ADCInstallISR(void)
+{
+			VicInstall(VIC_SLOT_ADC,ADC_VIC_CHNO,(u32)ADC_ISR,"ADC");
+}
+
+//------------------------------------------------------------
+// Function: Start_ADCScan
+// Purpose : Continuously convert a set of channels in BURST mode
+// Method  : Hardware cycles through every selected channel; the
+//           DONE interrupt latches each result per channel, so the
+//           latest value of any channel is a plain memory load
+// Argument: chMask - bit n set to scan AINn (0x01 - 0x0F)
+// Note     : Read_ADC must not be used once scanning is running
+//------------------------------------------------------------
+
+void Start_ADCScan(u32 chMask)
+{
+			u32 ch;
+	
+			chMask&=0x0F;
+			for(ch=0;ch<4;ch++)
+			{
+				if((chMask>>ch)&1)
+				{
+					// Configure AIN pin for ADC peripheral function
+					PINSEL1&=~(adcChSel[ch]);
+					PINSEL1|=adcChSel[ch];
+				}
+				adcSeq[ch]=0;
+				adcSeqSent[ch]=0;
+				adcChAcc[ch]=0;
+				adcChCnt[ch]=0;
+			}
+			adcScanMask=chMask;
+	
+			ADCInstallISR();
+	
+			// Channel mask, slower scan clock, BURST, powered, START=000
+			ADCR=chMask|(ADC_SCAN_CLKDIV<<CLKDIV_BITS)|(1<<BURST_BIT)|(1<<PDN_BIT);
+}
+
+//------------------------------------------------------------
+// Function: Get_ADCLatest
+// Purpose : Read latest burst-scan result of a channel
+// Arguments:
+// chNo     - ADC channel number (03)
+// code     - Pointer to store latest 10+ovs bit result
+// ovs      - Pointer to store extra bits from oversampling
+// Return   : Sequence count of that result (0 = none yet)
+//------------------------------------------------------------
+
+u32 Get_ADCLatest(u32 chNo,u32 *code,u32 *ovs)
+{
+			u32 seq;
+	
+			chNo&=3;
+			// Re-read if the ISR latched a new result in between
+			do
+			{
+				seq=adcSeq[chNo];
+				*code=adcLatest[chNo];
+				*ovs=adcLatestOvs[chNo];
+			}while(seq!=adcSeq[chNo]);
+	
+			return seq;
+}
+
+//------------------------------------------------------------
+// Function: Start_ADCSampler
+// Purpose : Start fixed-rate sampling of one ADC channel
+// Method  : Timer0 MR0 resets TC and interrupts every 1/rateHz s.
+//           Each tick starts a burst of 4^n conversions which the
+//           ADC DONE interrupt collects, so no ISR waits on the ADC.
+//           If Start_ADCScan() is running, each tick instead pushes
+//           the latest result of every scanned channel.
+// Arguments:
+// chNo     - ADC channel number (03), already set up by Init_ADC
+//            (ignored in burst-scan mode)
+// rateHz   - Sample rate, ADC_SAMPLE_HZ_MIN to ADC_SAMPLE_HZ_MAX
+// Note     : Read_ADC must not be used once sampling is running
+//------------------------------------------------------------
+
+void Start_ADCSampler(u32 chNo,u32 rateHz)
+{
+			if(rateHz<ADC_SAMPLE_HZ_MIN)
+				rateHz=ADC_SAMPLE_HZ_MIN;
+			if(rateHz>ADC_SAMPLE_HZ_MAX)
+				rateHz=ADC_SAMPLE_HZ_MAX;
 			
-			// Compute differential voltage & convert into temperature
-			tDeg=eAR1* 100;
-		
-			return tDeg;
+			adcSmpCh=chNo;
+			adcRateHz=rateHz;
+			adcBusy=0;
+	
+			ADCInstallISR();
+	
+			// Timer0 counts PCLK, match every PCLK/rateHz with reset
+			T0TCR=1<<TCR_RESET_BIT;
+			T0PR=0;
+			T0MR0=(PCLK/rateHz)-1;
+			T0MCR=(1<<MR0I_BIT)|(1<<MR0R_BIT);
+	
+			// Install Timer0 ISR in its VIC vectored slot (highest priority)
+			VicInstall(VIC_SLOT_TIMER0,TIMER0_VIC_CHNO,(u32)Timer0_ISR,"T0");
+	
+			// Start Timer0
+			T0TCR=1<<TCR_EN_BIT;
+}
+
+//------------------------------------------------------------
+// Function: Set_ADCOversample
+// Purpose : Select oversampling for a channel, applied from the
+//           next sample on
+// Arguments:
+// chNo     - ADC channel number (03)
+// extraBits- n = 0 (plain 10-bit) to ADC_OVS_BITS_MAX; each sample
+//            is then the decimated sum of 4^n conversions
+//------------------------------------------------------------
+
+void Set_ADCOversample(u32 chNo,u32 extraBits)
+{
+			if(extraBits>ADC_OVS_BITS_MAX)
+				extraBits=ADC_OVS_BITS_MAX;
+			adcOvsBits[chNo&3]=extraBits;
 }
 
+//------------------------------------------------------------
+// Function: ADCStartConv
+// Purpose : Software start of one conversion on sampled channel
+//------------------------------------------------------------
+
+static void ADCStartConv(void)
+{
+			ADCR=(ADCR&~(ADC_START_MASK|0xFF))|(1<<adcSmpCh)|(1<<ADC_CONV_START_BIT);
+}
+
+//------------------------------------------------------------
+// Function: ADCRingPush
+// Purpose : Append one sample to the sample ring (ISR side)
+//------------------------------------------------------------
+
+static void ADCRingPush(u32 ts,u32 ms,u32 code,u32 ch,u32 ovs)
+{
+			u32 next=(adcRingHead+1)&ADC_RING_MASK;
+	
+			if(next==adcRingTail)
+			{
+				adcRingOvfCnt++;
+				return;
+			}
+			adcRing[adcRingHead].ts=ts;
+			adcRing[adcRingHead].ms=ms;
+			adcRing[adcRingHead].code=code;
+			adcRing[adcRingHead].ch=ch;
+			adcRing[adcRingHead].ovs=ovs;
+			adcRingHead=next;
+}
+
+//------------------------------------------------------------
+// Function: ADCAlertCheck
+// Purpose : Compare a finished result with the alert thresholds
+//           and switch LED / alert flag on a change (ISR side)
+//------------------------------------------------------------
+
+static void ADCAlertCheck(u32 ch,u32 code,u32 ovs)
+{
+			if(ch!=adcAlertCh)
+				return;
+			code<<=ADC_OVS_BITS_MAX-ovs;
+	
+			if(code>=adcAlertTrip)
+			{
+				if(!adcAlert)
+				{
+					adcAlert=1;
+					IOSET1=1<<LED;
+				}
+			}
+			else if(code<adcAlertClr)
+			{
+				if(adcAlert)
+				{
+					adcAlert=0;
+					IOCLR1=1<<LED;
+				}
+			}
+}
+
+//------------------------------------------------------------
+// Function: Timer0_ISR
+// Purpose : Start the oversampling burst for the next sample, or
+//           in burst-scan mode push each channel's latest result
+//------------------------------------------------------------
+
+void Timer0_ISR(void) __irq
+{
+			u32 ch,ts,t0;
+			u16 ms;
+	
+			// TC restarted at the match, so it counts PCLK ticks of latency
+			t0=VicIsrEnter();
+			VicLatency(VIC_SLOT_TIMER0,T0TC/(PCLK/1000000));
+	
+			// Clear MR0 interrupt flag
+			T0IR=1<<MR0_INT_BIT;
+	
+			if(adcScanMask)
+			{
+				ts=GetRTCTimestampMs(&ms);
+				for(ch=0;ch<4;ch++)
+				{
+					if(((adcScanMask>>ch)&1) && (adcSeq[ch]!=adcSeqSent[ch]))
+					{
+						adcSeqSent[ch]=adcSeq[ch];
+						ADCRingPush(ts,ms,adcLatest[ch],ch,adcLatestOvs[ch]);
+					}
+				}
+			}
+			else if(adcBusy)
+				adcSkipCnt++;
+			else
+			{
+				adcPendTs=GetRTCTimestampMs(&adcPendMs);
+				adcAcc=0;
+				adcAccCnt=0;
+				adcAccBits=adcOvsBits[adcSmpCh];
+				adcBusy=1;
+				ADCStartConv();
+			}
+	
+			VicIsrExit(VIC_SLOT_TIMER0,t0);
+	
+			// Acknowledge interrupt to VIC
+			VICVectAddr=0;
+}
+
+//------------------------------------------------------------
+// Function: ADC_ISR
+// Purpose : Accumulate each finished conversion; start the next
+//           until 4^n are summed, then push the decimated sample
+//------------------------------------------------------------
+
+void ADC_ISR(void) __irq
+{
+			u32 addr,code,ch,n,t0;
+	
+			t0=VicIsrEnter();
+	
+			// Reading ADDR returns result and clears DONE/interrupt
+			addr=ADDR;
+			code=(addr>>DIGITAL_DATA_BITS)&1023;
+	
+			if(adcScanMask)
+			{
+				// Burst-scan : accumulate per channel, latch when 4^n done;
+				// n is fixed per accumulation so Set_ADCOversample() can't
+				// change the shift of a sum already in progress
+				ch=(addr>>ADC_CHN_BITS)&3;
+				if(adcChCnt[ch]==0)
+					adcChBits[ch]=adcOvsBits[ch];
+				n=adcChBits[ch];
+				adcChAcc[ch]+=code;
+				if(++adcChCnt[ch]>=(1UL<<(2*n)))
+				{
+					adcLatest[ch]=adcChAcc[ch]>>n;
+					adcLatestOvs[ch]=n;
+					adcSeq[ch]++;
+					ADCAlertCheck(ch,adcLatest[ch],n);
+					adcChAcc[ch]=0;
+					adcChCnt[ch]=0;
+				}
+			}
+			else
+			{
+				adcAcc+=code;
+				if(++adcAccCnt<(1UL<<(2*adcAccBits)))
+					ADCStartConv();
+				else
+				{
+					// Sum of 4^n codes >> n gives a 10+n bit result
+					ADCRingPush(adcPendTs,adcPendMs,adcAcc>>adcAccBits,adcSmpCh,adcAccBits);
+					ADCAlertCheck(adcSmpCh,adcAcc>>adcAccBits,adcAccBits);
+					adcBusy=0;
+				}
+			}
+	
+			VicIsrExit(VIC_SLOT_ADC,t0);
+	
+			// Acknowledge interrupt to VIC
+			VICVectAddr=0;
+}
+
+//------------------------------------------------------------
+// Function: Get_ADCSample
+// Purpose : Remove oldest sample from the sample ring
+// Argument: smp - Pointer to store sample
+// Return  : 1 if a sample was read, 0 if ring is empty
+//------------------------------------------------------------
+
+u32 Get_ADCSample(ADCSample *smp)
+{
+			if(adcRingTail==adcRingHead)
+				return 0;
+			*smp=adcRing[adcRingTail];
+			adcRingTail=(adcRingTail+1)&ADC_RING_MASK;
+			return 1;
+}
+
+//------------------------------------------------------------
+// Function: Get_ADCOvfCount
+// Purpose : Return number of samples dropped on a full ring
+//------------------------------------------------------------
+
+u32 Get_ADCOvfCount(void)
+{
+			return adcRingOvfCnt;
+}
+
+//------------------------------------------------------------
+// Function: Get_ADCDropCount
+// Purpose : Return number of sampler ticks that produced no
+//           sample (ring full or previous burst still running)
+//------------------------------------------------------------
+
+u32 Get_ADCDropCount(void)
+{
+			return adcRingOvfCnt+adcSkipCnt;
+}
+
+//------------------------------------------------------------
+// Function: Get_ADCRate
+// Purpose : Return sampler rate in Hz (after range limiting)
+//------------------------------------------------------------
+
+u32 Get_ADCRate(void)
+{
+			return adcRateHz;
+}
+
+//------------------------------------------------------------
+// Function: ADCAlertCode
+// Purpose : First code (at ADC_OVS_BITS_MAX extra bits) whose
+//           temperature is above mDeg, or not below it if orEq
+// Method  : Binary search, the calibrated table is monotonic
+// Return  : ADC_ALERT_CODE_END if no code qualifies
+//------------------------------------------------------------
+
+static u32 ADCAlertCode(u32 chNo,s32 mDeg,u32 orEq)
+{
+			u32 lo=0,hi=ADC_ALERT_CODE_END,mid;
+			s32 t;
+	
+			while(lo<hi)
+			{
+				mid=(lo+hi)>>1;
+				t=Conv_LM35_mC_OS(chNo,mid,ADC_OVS_BITS_MAX);
+				if((t>mDeg) || (orEq && (t==mDeg)))
+					hi=mid;
+				else
+					lo=mid+1;
+			}
+			return lo;
+}
+
+//------------------------------------------------------------
+// Function: Set_ADCAlert
+// Purpose : Arm the ADC_ISR over-temperature comparator
+// Arguments:
+// chNo     - ADC channel compared (ADC_ALERT_OFF to disable)
+// mDeg     - Alert setpoint in mC; above it the LED turns on,
+//            below it off
+// Note     : Thresholds are computed here at task level so the
+//            ISR only compares two integers
+//------------------------------------------------------------
+
+void Set_ADCAlert(u32 chNo,s32 mDeg)
+{
+			u32 trip=0,clr=0,irq;
+	
+			if(chNo!=ADC_ALERT_OFF)
+			{
+				trip=ADCAlertCode(chNo,mDeg,0);
+				clr=ADCAlertCode(chNo,mDeg,1);
+			}
+	
+			// Thresholds and channel change together for the ISR
+			irq=VicMask(1<<ADC_VIC_CHNO);
+			adcAlertTrip=trip;
+			adcAlertClr=clr;
+			adcAlertCh=chNo;
+			VicRestore(irq);
+}
+
+//------------------------------------------------------------
+// Function: Get_ADCAlert
+// Purpose : Return 1 while the compared channel is over the
+//           alert setpoint (state set by ADC_ISR)
+//------------------------------------------------------------
+
+u32 Get_ADCAlert(void)
+{
+			return adcAlert;
+}
+
+//------------------------------------------------------------
+// Function: Conv_LM35
+// Purpose : Convert a 10-bit ADC code to LM35 temperature
+// Argument: adcDVal - 10-bit ADC digital value
+// Return  : Temperature in C
+//------------------------------------------------------------
+
+f32 Conv_LM35(u32 adcDVal)
+{
+			return (adcDVal * (3.3/1023)) * 100;
+}
+
+//------------------------------------------------------------
+// Function: Conv_LM35_mC
+// Purpose : Convert a 10-bit ADC code to calibrated LM35 temperature
+// Method  : Single indexed load from the build-time lookup table
+// Arguments:
+// chNo     - ADC channel number (03), selects calibration
+// adcDVal  - 10-bit ADC digital value
+// Return   : Temperature in mC
+//------------------------------------------------------------
+
+s32 Conv_LM35_mC(u32 chNo,u32 adcDVal)
+{
+			return lm35LutC[chNo&3][adcDVal&ADC_MAX_CODE];
+}
+
+//------------------------------------------------------------
+// Function: Conv_LM35_mDeg
+// Purpose : Convert a 10-bit ADC code to calibrated LM35 temperature
+//           in the requested unit
+// Arguments:
+// chNo     - ADC channel number (03), selects calibration
+// adcDVal  - 10-bit ADC digital value
+// tType    - 'C' for Celsius, 'F' for Fahrenheit
+// Return   : Temperature in mC or mF
+//------------------------------------------------------------
+
+s32 Conv_LM35_mDeg(u32 chNo,u32 adcDVal,u8 tType)
+{
+			if(tType=='F')
+				return lm35LutF[chNo&3][adcDVal&ADC_MAX_CODE];
+			return lm35LutC[chNo&3][adcDVal&ADC_MAX_CODE];
+}
+
+//------------------------------------------------------------
+// Function: Conv_LM35_mC_OS
+// Purpose : Convert an oversampled (10+n bit) code to calibrated
+//           LM35 temperature by interpolating the lookup table
+// Arguments:
+// chNo     - ADC channel number (03), selects calibration
+// code     - 10+n bit decimated ADC value
+// extraBits- n, number of bits gained by oversampling
+// Return   : Temperature in mC
+//------------------------------------------------------------
+
+s32 Conv_LM35_mC_OS(u32 chNo,u32 code,u32 extraBits)
+{
+			const s32 *lut=lm35LutC[chNo&3];
+			u32 idx=code>>extraBits;
+			u32 frac=code&((1UL<<extraBits)-1);
+	
+			if(idx>=ADC_MAX_CODE)
+				return lut[ADC_MAX_CODE];
+			return lut[idx]+(((lut[idx+1]-lut[idx])*(s32)frac)>>extraBits);
+}
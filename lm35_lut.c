@@ -0,0 +1,56 @@
+/*===============================================================
+File: lm35_lut.c
+Purpose: ADC code to LM35 temperature lookup tables (millidegrees).
+Every entry is a constant expression built from ADC_VREF, the LM35
+slope and the per-channel gain/offset calibration constants in
+adc_defines_mini.h, so the compiler generates the 1024-entry tables
+at build time and no conversion math runs on the target.
+- lm35LutC : mC for AIN0 - AIN3
+- lm35LutF : mF for AIN0 - AIN3
+===============================================================*/
+
+//Header file containing project-specific definitions & prototypes
+#include "Mini_headers.h"
+
+//---------------------------------------------------------
+// Table entry for ADC code c with channel gain g and offset o (mC)
+// mC = c * VREF / 1023 [V] * 1000/slope [C/V] * 1000 [mC/C]
+//---------------------------------------------------------
+
+#define LM35_MC(c,g,o) (((c)*(ADC_VREF*1000000.0/LM35_MV_PER_DEG)/ADC_MAX_CODE)*(g)+(o))
+#define LUT_C(c,g,o)   ((s32)(LM35_MC(c,g,o)+0.5))
+#define LUT_F(c,g,o)   ((s32)((LM35_MC(c,g,o)*9.0/5.0)+32000.0+0.5))
+
+//---------------------------------------------------------
+// Repeat helpers expanding a table entry macro over 1024 codes
+//---------------------------------------------------------
+
+#define LUT4(E,b,g,o)    E((b),g,o),E((b)+1,g,o),E((b)+2,g,o),E((b)+3,g,o)
+#define LUT16(E,b,g,o)   LUT4(E,b,g,o),LUT4(E,(b)+4,g,o),LUT4(E,(b)+8,g,o),LUT4(E,(b)+12,g,o)
+#define LUT64(E,b,g,o)   LUT16(E,b,g,o),LUT16(E,(b)+16,g,o),LUT16(E,(b)+32,g,o),LUT16(E,(b)+48,g,o)
+#define LUT256(E,b,g,o)  LUT64(E,b,g,o),LUT64(E,(b)+64,g,o),LUT64(E,(b)+128,g,o),LUT64(E,(b)+192,g,o)
+#define LUT1024(E,g,o)   {LUT256(E,0,g,o),LUT256(E,256,g,o),LUT256(E,512,g,o),LUT256(E,768,g,o)}
+
+//---------------------------------------------------------
+// Per-channel Celsius tables (mC)
+//---------------------------------------------------------
+
+const s32 lm35LutC[4][ADC_LUT_SIZE]=
+{
+	LUT1024(LUT_C,LM35_CAL0_GAIN,LM35_CAL0_OFS_MC),
+	LUT1024(LUT_C,LM35_CAL1_GAIN,LM35_CAL1_OFS_MC),
+	LUT1024(LUT_C,LM35_CAL2_GAIN,LM35_CAL2_OFS_MC),
+	LUT1024(LUT_C,LM35_CAL3_GAIN,LM35_CAL3_OFS_MC)
+};
+
+//---------------------------------------------------------
+// Per-channel Fahrenheit tables (mF)
+//---------------------------------------------------------
+
+const s32 lm35LutF[4][ADC_LUT_SIZE]=
+{
+	LUT1024(LUT_F,LM35_CAL0_GAIN,LM35_CAL0_OFS_MC),
+	LUT1024(LUT_F,LM35_CAL1_GAIN,LM35_CAL1_OFS_MC),
+	LUT1024(LUT_F,LM35_CAL2_GAIN,LM35_CAL2_OFS_MC),
+	LUT1024(LUT_F,LM35_CAL3_GAIN,LM35_CAL3_OFS_MC)
+};
@@ -3,3 +3,8 @@
 //void Read_LM35(f32 *tdegC,f32 *tdegF);
 f32 Read_LM35(u8 tType);
 f32 Read_LM35_NP(u8 tType);
+f32 Conv_LM35(u32 adcDVal);
+s32 Read_LM35_mDeg(u8 tType);
+s32 Conv_LM35_mC(u32 chNo,u32 adcDVal);
+s32 Conv_LM35_mDeg(u32 chNo,u32 adcDVal,u8 tType);
+s32 Conv_LM35_mC_OS(u32 chNo,u32 code,u32 extraBits);
@@ -0,0 +1,306 @@
+/*===============================================================
+File: log.c
+Purpose: Temperature log records over UART0.
+A record is formatted in one pass into a stack buffer and queued
+with a single UARTTxSpan() call, so it is either sent whole or
+dropped whole when the transmit ring is full. Fixed layout:
+  [ALERT!] Temp: 23.456C @  HH:MM:SS.mmm DD/MM/YYYY - OVER TEMP
+or, with LOG_EPOCH_TS, seconds since 1970 in place of time/date.
+In LOG_MODE_BINARY the same record goes out as a 15-byte
+FRAME_TYPE_LOG frame (frame.c) with a sequence number.
+Binary mode also batches raw samples per channel: LogBatchAdd()
+collects codes as zig-zag/varint deltas behind one timestamp and
+sends a FRAME_TYPE_BATCH frame when the batch is full, too old,
+or the sample stream has a gap (see frame_defines_mini.h).
+===============================================================*/
+
+//Header file containing project-specific definitions & prototypes
+#include "Mini_headers.h"
+
+u8 logMode=LOG_MODE_DEFAULT;	// LOG_MODE_ASCII / LOG_MODE_BINARY
+u16 logSeq=0;									// Binary records emitted, wraps at 65536
+
+//---------------------------------------------------------
+// Per-channel sample batch (frame payload built in place)
+//---------------------------------------------------------
+typedef struct
+{
+		u8  buf[FRAME_MAX_PAYLOAD];	// Payload, header + deltas
+		u32 len;									// Bytes used, 0 = no batch open
+		u32 cnt;									// Samples in batch
+		u32 prev;									// Last code, for the next delta
+		u32 msd0;									// Millisecond of day of first sample
+		u32 us;										// Sample period in s
+		u32 tol;									// Allowed timestamp error in ms
+		u32 dl;										// Flush deadline (timebase s)
+		u32 drops;								// Get_ADCDropCount() when opened
+}LogBatch;
+
+LogBatch logBatch[4];
+u32 logBatchMaxN=LOG_BATCH_N;
+u32 logBatchMaxUs=LOG_BATCH_MS*1000UL;
+u16 logBatchSeq=0;
+
+//------------------------------------------------------------
+// Function: LogPutStr
+// Purpose : Copy NUL terminated string, return next position
+//------------------------------------------------------------
+
+static u8 *LogPutStr(u8 *p,const s8 *s)
+{
+			while(*s)
+				*p++=*s++;
+			return p;
+}
+
+//------------------------------------------------------------
+// Function: LogPut2
+// Purpose : Two digits 0099 from digit table, return next position
+//------------------------------------------------------------
+
+static u8 *LogPut2(u8 *p,u32 v)
+{
+			*p++=DIG2_TENS(v);
+			*p++=DIG2_ONES(v);
+			return p;
+}
+
+//------------------------------------------------------------
+// Function: LogSetMode
+// Purpose : Select ASCII lines or binary frames for log records
+//------------------------------------------------------------
+
+void LogSetMode(u32 mode)
+{
+			logMode=mode;
+}
+
+//------------------------------------------------------------
+// Function: LogBinRecord
+// Purpose : Pack one record as a FRAME_TYPE_LOG frame and queue it
+//------------------------------------------------------------
+
+static void LogBinRecord(u32 sev,u32 ch,s32 mDeg,u32 ts,u16 ms)
+{
+			u8 rec[FRAME_LOG_LEN];
+			s32 cDeg;
+			u32 w;
+	
+			// mC to 0.01 C, rounded, limited to s16
+			cDeg=(mDeg<0)?-(s32)DIV10(5-mDeg):(s32)DIV10(mDeg+5);
+			if(cDeg>32767)
+				cDeg=32767;
+			if(cDeg<-32768)
+				cDeg=-32768;
+	
+			w=ms|((ch&3)<<FRAME_LOG_CH_SHIFT);
+			if(sev==LOG_SEV_ALERT)
+				w|=FRAME_LOG_FLAG_ALERT<<FRAME_LOG_FLAG_SHIFT;
+	
+			rec[0]=FRAME_TYPE_LOG;
+			rec[1]=logSeq;
+			rec[2]=logSeq>>8;
+			rec[3]=ts;
+			rec[4]=ts>>8;
+			rec[5]=ts>>16;
+			rec[6]=ts>>24;
+			rec[7]=w;
+			rec[8]=w>>8;
+			rec[9]=cDeg;
+			rec[10]=cDeg>>8;
+	
+			FrameSend(rec,FRAME_LOG_LEN);
+			logSeq++;
+}
+
+//------------------------------------------------------------
+// Function: LogRecord
+// Purpose : Format and queue one temperature log record
+// Arguments:
+// sev  - LOG_SEV_NORMAL or LOG_SEV_ALERT
+// ch   - ADC channel the temperature was measured on
+// mDeg - Temperature in mC
+// ts   - Packed RTC timestamp, ms - millisecond within ts
+//------------------------------------------------------------
+
+void LogRecord(u32 sev,u32 ch,s32 mDeg,u32 ts,u16 ms)
+{
+			u8 rec[LOG_REC_MAX];
+			u8 *p=rec;
+			u32 whole;
+	
+			if(logMode==LOG_MODE_BINARY)
+			{
+				LogBinRecord(sev,ch,mDeg,ts,ms);
+				return;
+			}
+	
+			if(sev==LOG_SEV_ALERT)
+				p=LogPutStr(p,"[ALERT!] ");
+	
+			// Temperature, 3 decimals
+			p=LogPutStr(p,"Temp: ");
+			if(mDeg<0)
+			{
+				*p++='-';
+				mDeg=-mDeg;
+			}
+			whole=DIV1000(mDeg);
+			p+=FmtU32(p,whole,1);
+			*p++='.';
+			p+=FmtU32(p,mDeg-whole*1000,3);
+			p=LogPutStr(p,"\xF8" "C @  ");
+	
+			// Timestamp
+#ifdef LOG_EPOCH_TS
+			p+=FmtU32(p,RTCTsToEpoch(ts),1);
+			*p++='.';
+			p+=FmtU32(p,ms,3);
+#else
+			p=LogPut2(p,RTC_TS_HOUR(ts));
+			*p++=':';
+			p=LogPut2(p,RTC_TS_MIN(ts));
+			*p++=':';
+			p=LogPut2(p,RTC_TS_SEC(ts));
+			*p++='.';
+			p+=FmtU32(p,ms,3);
+			*p++=' ';
+			p=LogPut2(p,RTC_TS_DATE(ts));
+			*p++='/';
+			p=LogPut2(p,RTC_TS_MONTH(ts));
+			*p++='/';
+			p+=FmtU32(p,RTC_TS_YEAR(ts),4);
+#endif
+	
+			if(sev==LOG_SEV_ALERT)
+				p=LogPutStr(p," - OVER TEMP");
+			*p++='\n';
+			*p++='\r';
+	
+			UARTTxSpan(rec,p-rec);
+}
+
+//------------------------------------------------------------
+// Function: LogBatchConfig
+// Purpose : Set batch size and flush deadline
+// Arguments: maxN  - Samples per frame (0 = batching off),
+//                    limited to 255 and to the frame size
+//            maxMs - Send a batch once its first sample is this old
+//------------------------------------------------------------
+
+void LogBatchConfig(u32 maxN,u32 maxMs)
+{
+			if(maxN>255)
+				maxN=255;
+			logBatchMaxN=maxN;
+			logBatchMaxUs=maxMs*1000UL;
+}
+
+//------------------------------------------------------------
+// Function: LogBatchFlush
+// Purpose : Send and close one channel batch
+//------------------------------------------------------------
+
+static void LogBatchFlush(LogBatch *b)
+{
+			if(!b->len)
+				return;
+			b->buf[11]=b->cnt;
+			FrameSend(b->buf,b->len);
+			b->len=0;
+}
+
+//------------------------------------------------------------
+// Function: LogBatchAdd
+// Purpose : Append one sample to the batch of its channel; open,
+//           close or send batches as needed
+// Argument: smp - Sample from Get_ADCSample()
+// Note    : Does nothing unless in LOG_MODE_BINARY with batching on
+//------------------------------------------------------------
+
+void LogBatchAdd(const ADCSample *smp)
+{
+			LogBatch *b=&logBatch[smp->ch&3];
+			u32 msd,ofs,z;
+			s32 d;
+	
+			if(logMode!=LOG_MODE_BINARY || !logBatchMaxN)
+				return;
+	
+			// Millisecond of day; batches do not span midnight
+			msd=((RTC_TS_HOUR(smp->ts)*60+RTC_TS_MIN(smp->ts))*60+RTC_TS_SEC(smp->ts))*1000UL+smp->ms;
+	
+			if(b->len)
+			{
+				// Close on oversampling change, lost samples, or a timestamp
+				// too far (> half a period, min 1 ms) from first + cnt/rate
+				ofs=b->msd0+DIV1000(b->cnt*b->us);
+				if(((b->buf[8]>>(FRAME_BATCH_OVS_SHIFT-8))&3)!=smp->ovs ||
+				   Get_ADCDropCount()!=b->drops ||
+				   (msd>ofs?msd-ofs:ofs-msd)>b->tol)
+					LogBatchFlush(b);
+			}
+	
+			if(!b->len)
+			{
+				// Open batch : header + first code
+				b->buf[0]=FRAME_TYPE_BATCH;
+				b->buf[1]=logBatchSeq;
+				b->buf[2]=logBatchSeq>>8;
+				b->buf[3]=smp->ts;
+				b->buf[4]=smp->ts>>8;
+				b->buf[5]=smp->ts>>16;
+				b->buf[6]=smp->ts>>24;
+				z=smp->ms|((smp->ch&3)<<FRAME_LOG_CH_SHIFT)|((smp->ovs&3)<<FRAME_BATCH_OVS_SHIFT);
+				b->buf[7]=z;
+				b->buf[8]=z>>8;
+				z=Get_ADCRate();
+				b->buf[9]=z;
+				b->buf[10]=z>>8;
+				b->us=1000000UL/z;
+				b->tol=(500/z)|1;
+				b->buf[12]=smp->code;
+				b->buf[13]=smp->code>>8;
+				b->len=FRAME_BATCH_HDR_LEN;
+				b->cnt=1;
+				b->prev=smp->code;
+				b->msd0=msd;
+				b->dl=DeadlineSet(logBatchMaxUs);
+				b->drops=Get_ADCDropCount();
+				logBatchSeq++;
+			}
+			else
+			{
+				// Zig-zag maps small +/- deltas to small unsigned values
+				d=(s32)smp->code-(s32)b->prev;
+				z=((u32)d<<1)^(u32)(d>>31);
+				while(z>=0x80)
+				{
+					b->buf[b->len++]=z|0x80;
+					z>>=7;
+				}
+				b->buf[b->len++]=z;
+				b->cnt++;
+				b->prev=smp->code;
+			}
+	
+			if(b->cnt>=logBatchMaxN || (b->len+FRAME_VARINT_MAX)>FRAME_MAX_PAYLOAD)
+				LogBatchFlush(b);
+}
+
+//------------------------------------------------------------
+// Function: LogBatchPoll
+// Purpose : Send every batch whose flush deadline has passed
+// Note    : Call from the main loop
+//------------------------------------------------------------
+
+void LogBatchPoll(void)
+{
+			u32 ch;
+	
+			for(ch=0;ch<4;ch++)
+			{
+				if(logBatch[ch].len && DeadlinePassed(logBatch[ch].dl))
+					LogBatchFlush(&logBatch[ch]);
+			}
+}
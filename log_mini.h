@@ -0,0 +1,14 @@
+//log.h
+#ifndef LOG_H
+#define LOG_H
+
+#include "types.h"
+#include "adc_mini.h"
+
+void LogRecord(u32 sev,u32 ch,s32 mDeg,u32 ts,u16 ms);
+void LogSetMode(u32 mode);
+void LogBatchConfig(u32 maxN,u32 maxMs);
+void LogBatchAdd(const ADCSample *smp);
+void LogBatchPoll(void);
+
+#endif
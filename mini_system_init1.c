@@ -6,6 +6,10 @@ Purpose : Real-time Temperature Monitoring System using LPC21xx
           - UART logging with timestamp
           - Over-temperature alert with LED
           - Editable RTC & temperature setpoint via keypad
+          - Edit menus run as a table-driven state machine
+            stepped from a scheduled task, so sensing never stops
+          - Work is split into tasks run by the cooperative
+            scheduler (sched.c), registered in main()
 ===============================================================*/
 #include<LPC21xx.h>
 #include "Mini_headers.h"
@@ -15,702 +19,436 @@ Purpose : Real-time Temperature Monitoring System using LPC21xx
 Global Variables
 --------------------------------------------------------------------*/
 s32 hour,min,sec,date,month,year,day;
+int setpoint=46;// Default temperature value
 extern u8 KEY[4][4];// Keypad matrix
-extern char week[][4];// Weekday strings (SUN, MON, ...)
 
+/*--------------------------------------------------------------------
+Edit Menu State
+--------------------------------------------------------------------*/
+typedef struct
+{
+		u8 *name;								// Field name shown as "SET <name>:"
+		s32 *cur;								// Live RTC value, copied on entry
+		s32 min,max;						// Allowed range
+		s32 (*dynMax)(void);		// Range upper limit if it varies (0 = use max)
+		u8 wrap;								// 1 -> wrap at limits, 0 -> clamp
+		u8 (*valid)(s32);				// Validation before save (0 = none)
+		void (*set)(s32);				// RTC setter
+		void (*show)(s32);			// Draw value at 0x8A
+		s8 *errMsg;							// UART warning when validation fails
+		s8 *okMsg;							// UART message after save (0 = none)
+}EditField;
+
+u8 menuState=MENU_IDLE;
+const EditField *editField;// Field being edited
+s32 editVal;// Working copy of edited field
+u32 menuMsgDl;// Deadline of the message screen
+
+
+
+/*--------------------------------------------------------------------
+Field helpers used by the edit field table
+--------------------------------------------------------------------*/
+static s32 DateMax(void)      { return DaysInMonth(year, month); }
+static u8  DateValid(s32 v)   { return (v >= 1 && v <= (s32)DaysInMonth(year, month)); }
+static void SetHour(s32 v)    { SetRTCTimeInfo(v, min, sec); }
+static void SetMin(s32 v)     { SetRTCTimeInfo(hour, v, sec); }
+static void SetSec(s32 v)     { SetRTCTimeInfo(hour, min, v); }
+static void SetDate(s32 v)    { SetRTCDateInfo(v, month, year); }
+static void SetMonth(s32 v)   { SetRTCDateInfo(date, v, year); }
+static void SetYear(s32 v)    { SetRTCDateInfo(date, month, v); }
+
+static void ShowNum(s32 v)
+{
+		CmdLCD(0x8A);
+		StrLCD("      ");// clear old value
+		CmdLCD(0x8A);
+		IntLCD(v);
+}
+
+/*--------------------------------------------------------------------
+Edit field table : index = key pressed in field selection menu - 1
+--------------------------------------------------------------------*/
+const EditField editFields[EDIT_FIELDS]=
+{
+	{"HOUR", &hour,  0, 23,   0,       1, 0,         SetHour,  ShowNum, 0, 0},
+	{"MIN",  &min,   0, 59,   0,       1, 0,         SetMin,   ShowNum, 0, 0},
+	{"SEC",  &sec,   0, 59,   0,       1, 0,         SetSec,   ShowNum, 0, 0},
+	{"DATE", &date,  1, 31,   DateMax, 1, DateValid, SetDate,  ShowNum,
+		"[WARN] Invalid Date Entered, Not Saved!\n\r","[OK] Date Updated Successfully!\n\r"},
+	{"MON",  &month, 1, 12,   0,       1, 0,         SetMonth, ShowNum, 0, 0},
+	{"YEAR", &year,  RTC_TS_YEAR_MIN, RTC_TS_YEAR_MAX, 0, 0, 0, SetYear, ShowNum, 0, 0},
+};
+
+/*--------------------------------------------------------------------
+Menu screens
+--------------------------------------------------------------------*/
+static void MenuShowMain(void)
+{
+		CmdLCD(0x01);//clear lcd
+		CmdLCD(0x80);
+		StrLCD("1.EDIT RTC INFO");
+		CmdLCD(0xC0);
+		StrLCD("2.E.SET");
+		CmdLCD(0xCA);
+		StrLCD("3.EXT");
+		
+		UARTTxStr("***EDIT MODE ACTIVATED***\n\r");
+		menuState=MENU_MAIN;
+}
+
+static void MenuShowFieldSel(void)
+{
+		CmdLCD(0x01);//Clear LCD
+		CmdLCD(0x80);
+		StrLCD("1.H 2.MI 3.S 4.D");
+		CmdLCD(0xC0);
+		StrLCD("5.M 6.Y      8.E");
+		menuState=MENU_FIELD_SEL;
+}
+
+static void MenuShowField(void)
+{
+		CmdLCD(0x01);       // Clear LCD
+		CmdLCD(0x80);       // 1st line start
+		StrLCD("SET ");
+		StrLCD(editField->name);
+		CharLCD(':');
+		editField->show(editVal);
+		menuState=MENU_FIELD;
+}
 
+static void MenuShowSetpoint(void)
+{
+		u32 h=DIV100(setpoint);
+	
+		// 3 digits at 0x8B, setpoint goes up to CMD_SP_MAX
+		FbGotoLCD(0x8b);
+		FbCharLCD(h ? '0'+h : ' ');
+		FbCharLCD(DIG2_TENS(setpoint-100*h));
+		FbCharLCD(DIG2_ONES(setpoint-100*h));
+		FbCharLCD(0xDF);     //  symbol
+		FbCharLCD('C');
+		FlushLCD();
+}
+
+/*--------------------------------------------------------------------
+Function: MenuAdjust
+Purpose : Step edited value by +1/-1 with wrap or clamp at the
+          limits taken from the field descriptor
+--------------------------------------------------------------------*/
+static void MenuAdjust(s32 step)
+{
+		s32 max=(editField->dynMax) ? editField->dynMax() : editField->max;
+		
+		editVal+=step;
+		if(editVal > max)
+				editVal=(editField->wrap) ? editField->min : max;
+		else if(editVal < editField->min)
+				editVal=(editField->wrap) ? max : editField->min;
+		
+		editField->show(editVal);
+}
+
+/*--------------------------------------------------------------------
+Function: MenuSaveField
+Purpose : Validate edited value and write it into the RTC, or show
+          a timed "not saved" message
+--------------------------------------------------------------------*/
+static void MenuSaveField(void)
+{
+		if(editField->valid && !editField->valid(editVal))
+		{
+				CmdLCD(0x01);//Clear LCD
+				CmdLCD(0x80);
+				StrLCD("? INVALID ");
+				StrLCD(editField->name);
+				CharLCD('!');
+				CmdLCD(0xC0);
+				StrLCD("Not Saved");
+				UARTTxStr(editField->errMsg);
+				menuMsgDl=DeadlineSet(MENU_MSG_US);
+				menuState=MENU_MSG;
+				return;
+		}
+		
+		editField->set(editVal);
+		if(editField->okMsg)
+				UARTTxStr(editField->okMsg);
+		MenuShowFieldSel();
+}
+
+/*--------------------------------------------------------------------
+Function: MenuStep
+Purpose : Advance edit menu state machine by at most one key event.
+          Never blocks; called once per main loop iteration.
+States  :
+   MENU_IDLE      -> monitoring screen, menu inactive
+   MENU_MAIN      -> 1.EDIT RTC INFO / 2.E.SET / 3.EXT
+   MENU_FIELD_SEL -> choose RTC field 1-6, 8 = back
+   MENU_FIELD     -> 15 increment, 16 decrement, 13 save
+   MENU_SETPOINT  -> 15 increment, 16 decrement, 13 back
+   MENU_MSG       -> timed message, returns to field selection
+--------------------------------------------------------------------*/
+void MenuStep(void)
+{
+		u8 key;
+		
+		switch(menuState)
+		{
+			case MENU_MAIN:
+				key=GetKeyPress();
+				if(key == 1)
+				{
+						UARTTxStr("***** Time Editing Mode Activated *****\n\r");
+						MenuShowFieldSel();
+				}
+				else if(key == 2)
+				{
+						CmdLCD(0x01);       // Clear LCD
+						CmdLCD(0x80);       // 1st line start
+						StrLCD("SET TEMP:");
+						MenuShowSetpoint();
+						UARTTxStr("*** Set Point Editing Mode Activated ***\n\r");
+						menuState=MENU_SETPOINT;
+				}
+				else if(key == 3)
+				{
+						CmdLCD(0x01);//Clear LCD
+						menuState=MENU_IDLE;
+				}
+				break;
+			
+			case MENU_FIELD_SEL:
+				key=GetKeyPress();
+				if(key == 8)
+						MenuShowMain();
+				else if(key >= 1 && key <= EDIT_FIELDS)
+				{
+						editField=&editFields[key-1];
+						editVal=*editField->cur;
+						MenuShowField();
+				}
+				break;
+			
+			case MENU_FIELD:
+				key=KeyVal();
+				if(key == KEY_INC)
+						MenuAdjust(1);
+				else if(key == KEY_DEC)
+						MenuAdjust(-1);
+				else if(key == KEY_OK)
+						MenuSaveField();
+				break;
+			
+			case MENU_SETPOINT:
+				key=GetKeyPress();
+				if(key == KEY_INC)
+				{
+						if(setpoint < CMD_SP_MAX)
+								setpoint++;
+						Set_ADCAlert(CH1,setpoint*1000);
+						MenuShowSetpoint();
+				}
+				else if(key == KEY_DEC)
+				{
+						if(setpoint > 0)
+								setpoint--;
+						Set_ADCAlert(CH1,setpoint*1000);
+						MenuShowSetpoint();
+				}
+				else if(key == KEY_OK)
+						MenuShowMain();
+				break;
+			
+			case MENU_MSG:
+				if(DeadlinePassed(menuMsgDl))
+						MenuShowFieldSel();
+				break;
+			
+			default:
+				break;
+		}
+}
+
+/*--------------------------------------------------------------------
+Monitoring State shared by the tasks
+--------------------------------------------------------------------*/
+s32 currentTemp;// Current temperature in mC
+u8 alertOn=0;// 1 -> over setpoint, LED on
+u32 lastTick;// RTC tick count last processed
+u8 normalLogged=0;// Normal state already reported
+u8 redraw=1;// Monitoring screen needs repaint
+u8 prevpres=0;// Edit switch state on previous scan
 
 /*--------------------------------------------------------------------
 Function: System_Init
 Purpose : 
     - Initialize RTC with default values
-    - Read & display temperature continuously
-    - Log data through UART
-    - Handle keypad based edit modes
+    - Start fixed-rate temperature sampling and RTC second tick
+    - The work itself is done by the tasks below, registered
+      with the scheduler in main()
 --------------------------------------------------------------------*/
 void System_Init(void)
 {
-		float currentTemp;// Stores current temperature
-		int setpoint=46;// Default temperature value
-		int cnt=0;//To prevent repeated UART prints
-		int	printonce=0;
-		s32 prevs=-1;
-		s32 prevs1=-1;
-
-	
-		
 /*------------------------------------------------------------
       Initialize RTC with default date and time
  ------------------------------------------------------------*/
 		SetRTCTimeInfo(12,14,00);// HH:MM:SS format
-		SetRTCDateInfo(30,10,2025);// DD/MM/YYYY format
-		SetRTCDay(4);
+		SetRTCDateInfo(30,10,2025);// DD/MM/YYYY format, sets day of week
 
 /*------------------------------------------------------------
       Startup message on UART
  ------------------------------------------------------------*/
-	if(printonce==0)
-	{
-	  UARTTxStr("LM35 TEST: \n\r");
+		currentTemp = Read_LM35_mDeg('C');
+		UARTTxStr("LM35 TEST: \n\r");
 		UARTTxStr("Temperature : ");
-		UARTTxF32(Read_LM35_NP('C'));
+		UARTTxMilli(currentTemp);
 		UARTTxStr("\xF8"); 
-					UARTTxStr("C\n\r");
-	}
+		UARTTxStr("C\n\r");
 	
 /*------------------------------------------------------------
-      Main Super Loop
+      Start LM35 burst scan and fixed-rate sampling (Timer0 paced)
  ------------------------------------------------------------*/
-		while(1)
-		{
-					int pres=0,prev=1;
-					
-/*--------------------------------------------------------
-          Read RTC values
- --------------------------------------------------------*/
-					INPUT:	
-					GetRTCTimeInfo(&hour,&min,&sec);
-					GetRTCDateInfo(&date,&month,&year);
-					GetRTCDay(&day);
-					
-/*--------------------------------------------------------
-          Display RTC on LCD
- --------------------------------------------------------*/
-					DisplayRTCTime(hour,min,sec);
-					DisplayRTCDate(date,month,year);
-					DisplayRTCDay(day);
-					
-/*--------------------------------------------------------
-          Read and display temperature
- --------------------------------------------------------*/
-					currentTemp = Read_LM35_NP('C'); 
-					
-					DisplayTemp((u32)currentTemp);
-					CharLCD(0xDF);// Degree symbol
-					CharLCD('C');	
-					
-/*--------------------------------------------------------
-          Temperature Normal Condition
- --------------------------------------------------------*/
-					if((currentTemp < setpoint)&&(cnt==0 || sec==0)) 
-					{ 
-						cnt++;
-						IODIR1|=(1<<LED);// Configure the LED pin as an output pin
-						IOCLR1 = 1<<LED;// Clearing the LED pin
-						
-				
-					if(sec != prevs1)
-					{
-						prevs1=sec;
-					UARTTxStr("Temp: "); 
-					UARTTxF32(currentTemp); 
-					UARTTxStr("\xF8"); 
-					UARTTxStr("C @ ");
-					 /* Print date */
-					UARTTxStr(" ");
-					if(hour<10) 
-						UARTTxChar('0'); 
-					UARTTxU32(hour); 
-					UARTTxChar(':');
-					if(min<10)  
-						UARTTxChar('0'); 
-					UARTTxU32(min);  
-					UARTTxChar(':');
-					if(sec<10)  
-						UARTTxChar('0'); 
-					UARTTxU32(sec);
-					UARTTxStr(" ");
-					
-					if(date < 10) 
-						UARTTxStr("0"); 
-					UARTTxU32(date); 
-					UARTTxStr("/"); 
-					if(month < 10) 
-						UARTTxStr("0"); 
-					UARTTxU32(month); 
-					UARTTxStr("/");
-					UARTTxU32(year); 
-					UARTTxStr("\n\r");
-					}
-					
-				}
-/*--------------------------------------------------------
-          Periodic Logging (Every Minute)
- --------------------------------------------------------*/
-					
-
-/*--------------------------------------------------------
-          Over-Temperature Condition
- --------------------------------------------------------*/					
-					else if(currentTemp > setpoint) 
-					{ 
-						cnt=0;// Reset normal print flag
-					if(sec != prevs)
-					{
-						prevs=sec;
-					
-							UARTTxStr("[ALERT!] "); 
-					UARTTxStr("Temp: "); 
-					UARTTxF32(currentTemp); 
-					UARTTxStr("\xF8"); 
-					UARTTxStr("C @ ");
-
-					UARTTxStr(" ");
-					if(hour<10) 
-						UARTTxChar('0'); 
-					UARTTxU32(hour); 
-					UARTTxChar(':');
-					if(min<10)  
-						UARTTxChar('0'); 
-					UARTTxU32(min);  
-					UARTTxChar(':');
-					if(sec<10)  
-						UARTTxChar('0'); 
-					UARTTxU32(sec);
-					UARTTxStr(" ");
-					
-					if(date < 10) 
-						UARTTxStr("0"); 
-					UARTTxU32(date); 
-					UARTTxStr("/"); 
-					if(month < 10) 
-						UARTTxStr("0"); 
-					UARTTxU32(month); 
-					UARTTxStr("/");
-					UARTTxU32(year); 
-					UARTTxStr(" - OVER TEMP");
-					UARTTxStr("\n\r");					
-					
-						IODIR1|=(1<<LED);
-						IOCLR1 = 1<<LED;
-						IOSET1 = 1<<LED; // LED ON at P0.13 
+		Start_ADCScan(ADC_SCAN_MASK);
+		Start_ADCSampler(CH1,ADC_SAMPLE_HZ);
 	
-					}
-				}
-/*--------------------------------------------------------
-          Switch Handling for Edit Mode
- --------------------------------------------------------*/
-					PINSEL2 &= ~(1<<SW);
-					IODIR1 &= ~(1<<SW);
-			
-					pres = (((IOPIN1 >> SW)&1)==0);
-/*--------------------------------------------------------
-          Enter Edit Mode on Switch Press
- --------------------------------------------------------*/					
-					if(pres && prev)
-					{
-						delay_ms(50);// Debounce delay
-						if(pres && prev)
-						{
-							
-							IN1:
-							CmdLCD(0x01);//clear lcd
-							CmdLCD(0x80);
-							StrLCD("1.EDIT RTC INFO");
-							CmdLCD(0xC0);
-							StrLCD("2.E.SET");
-							CmdLCD(0xCA);
-							StrLCD("3.EXT");
-							
-							UARTTxStr("***EDIT MODE ACTIVATED***\n\r");
-						
-/*------------------------------------------------
-                  Edit Menu Loop
- ------------------------------------------------*/							
-							while(1)
-							{
-								int opt,field,press=0;
-								//wait for sw press
-								delay_ms(10);//for avoiding keybouncing time.
-								
-								opt = GetKeyPress();
-
-/*=============================================================
-                  RTC Date & Time Editing Mode
-===============================================================
- Option 1 : RTC Date & Time Editing Mode
- Purpose :
-   - Allows user to modify RTC parameters using keypad
-			 15 -> Increment
-       10 -> Decrement
-       13 -> Exit / Save
-   - Editable fields:
-        Hour
-        Minute
-        Second
-        Date
-        Month
-        Year
-        Day of week
-   - Updated values are saved into RTC registers
-   - LCD provides live feedback during editing
-===============================================================*/
-
-								if(opt ==1)
-								{
-									IN:
-									CmdLCD(0x01);//Clear LCD
-									CmdLCD(0x80);
-									StrLCD("1.H 2.MI 3.S 4.D");
-									CmdLCD(0xC0);
-									StrLCD("5.M 6.Y 7.DY 8.E");
-
-									
-									if(press == 0)
-									{
-										UARTTxStr("***** Time Editing Mode Activated *****\n\r");
-										press++;
-									}
-									
-									field =GetKeyPress();
-									if(field == 15 || field == 14 || field == 13 || field == 12 || field ==11 || field ==10 || field ==0 )
-										goto IN;// Ignore invalid selection
-									
-									
-/*---------------------------------------------------------------
-Field 1 : Hour Editing
-Range : 0  23
-----------------------------------------------------------------*/
-									if(field == 1)
-									{
-										CmdLCD(0x01);       // Clear LCD
-										CmdLCD(0x80);       // 1st line start
-										StrLCD("SET HOUR:");
-										
-										
-										while (1)
-										{
-											int Key=KeyVal();
-												if (Key == 15)      // Increase hour
-												{
-														hour++;
-														if(hour==24)
-														{
-															hour=0;
-														}
-												}
-												else if (Key == 16) // Decrease hour
-												{
-																hour--;
-													if(hour < 0)
-														hour=23;
-												}
-												else if (Key  == 13) // Exit edit mode
-												{
-														SetRTCTimeInfo(hour, min, sec);
-														CmdLCD(0x01);//Clear LCD
-														goto IN;
-												}
-
-												CmdLCD(0x8A);       // 1st line
-												StrLCD("  ");       // small space
-												CmdLCD(0x8A);  
-												IntLCD(hour);// Show updated hour
-
-												delay_ms(200);     // small delay to avoid fast repeat
-										}	
-									}
-									
-/*---------------------------------------------------------------
- Field 2 : Minute Editing
- Range : 0  59
-----------------------------------------------------------------*/									
-									else if(field == 2)
-									{
-										CmdLCD(0x01);       // Clear LCD
-										CmdLCD(0x80);       // 1st line start
-										StrLCD("SET MIN:");
-										
-										
-										while (1)
-										{
-											int Key=KeyVal();
-												if (Key == 15)      // Increase min
-												{
-														min++;
-														if(min==60)
-														{
-															min=0;
-														}
-												}
-												else if (Key == 16) // Decrease min
-												{
-													min--;
-													if(min < 0)
-														min=59;
-												}
-												else if (Key  == 13) // Exit edit mode
-												{
-														SetRTCTimeInfo(hour, min, sec);
-														CmdLCD(0x01);//clear lcd
-														goto IN;
-												}
-
-												CmdLCD(0x8A);       // 1st line
-												StrLCD("  ");       // small space
-												CmdLCD(0x8A);  
-												IntLCD(min);// Show updated minutes
-
-												delay_ms(200);     // small delay to avoid fast repeat
-										}	
-									}
-									
-/*---------------------------------------------------------------
- Field 3 : Second Editing
- Range : 0  59
-----------------------------------------------------------------*/
-									else if(field == 3)
-									{
-										CmdLCD(0x01);       // Clear LCD
-										CmdLCD(0x80);       // 1st line start
-										StrLCD("SET SEC:");
-										
-										
-										while (1)
-										{
-											int Key=KeyVal();
-												if (Key == 15)      // Increase sec
-												{
-														sec++;
-														if(sec==60)
-														{
-															sec=0;
-														}
-												}
-												else if (Key == 16) // Decrease sec
-												{
-													sec--;
-													if(sec < 0)
-														sec=59;
-												}
-												else if (Key  == 13) // Exit edit mode
-												{
-														SetRTCTimeInfo(hour, min, sec);
-														CmdLCD(0x01);//Clear LCD
-														goto IN;
-												}
-
-												CmdLCD(0x8A);       // 1st line
-												StrLCD("  ");       // small space
-												CmdLCD(0x8A);  
-												IntLCD(sec);// Show updated seconds
-
-												delay_ms(200);     // small delay to avoid fast repeat
-										}	
-									}
-									
-/*---------------------------------------------------------------
- Field 4 : Date Editing
- Includes month & leap-year validation
-----------------------------------------------------------------*/
-									else if(field == 4)
-									{
-										CmdLCD(0x01);       // Clear LCD
-										CmdLCD(0x80);       // 1st line start
-										StrLCD("SET DATE:");
-										
-										
-										while (1)
-										{
-											int Key=KeyVal();
-												if (Key == 15)      // Increase date
-												{
-													date++;
-												}
-												else if (Key == 16) // Decrease date
-												{
-													date--;
-												}
-												else if (Key  == 13) // Exit edit mode
-												{
-														// ----- VALIDATION CHECK -----
-														int valid = 1;
-														int maxDate;
-
-														if(month == 2)
-														{
-																if(year % 4 == 0)
-																		maxDate = 29;
-																else
-																		maxDate = 28;
-														}
-														else if(month == 4 || month == 6 || month == 9 || month == 11)
-																maxDate = 30;
-														else
-																maxDate = 31;
-
-														if(date < 1 || date > maxDate)
-																valid = 0;
-
-														// ----- INVALID WARNING -----
-														if(!valid)
-														{
-																CmdLCD(0x01);//Clear LCD
-																CmdLCD(0x80);
-																StrLCD("? INVALID DATE!");
-																CmdLCD(0xC0);
-																StrLCD("Not Saved");
-																UARTTxStr("[WARN] Invalid Date Entered, Not Saved!\n\r");
-																delay_ms(1200);
-																CmdLCD(0x01);//Clear LCD
-																goto IN; // return without saving
-														}
-
-														// ----- SAVE ONLY IF VALID -----
-														SetRTCDateInfo(date, month, year);
-														UARTTxStr("[OK] Date Updated Successfully!\n\r");
-														CmdLCD(0x01);//Clear LCD
-														goto IN;
-												}
-
-												// ----- CYCLIC LIMITS DURING EDIT -----
-												if(month == 2)
-												{
-														if(year % 4 == 0)
-														{
-																if(date > 29) date = 1;
-																if(date < 1)  date = 29;
-														}
-														else
-														{
-																if(date > 28) date = 1;
-																if(date < 1)  date = 28;
-														}
-												}
-												else if(month == 4 || month == 6 || month == 9 || month == 11)
-												{
-														if(date > 30) date = 1;
-														if(date < 1)  date = 30;
-												}
-												else
-												{
-														if(date > 31) date = 1;
-														if(date < 1)  date = 31;
-												}
-
-												// ----- DISPLAY UPDATED DATE -----
-												CmdLCD(0x8A);
-												StrLCD("  ");
-												CmdLCD(0x8A);
-												IntLCD(date);
-
-												delay_ms(200);
-										}
-									}
-/*---------------------------------------------------------------
- Field 5 : Month Editing
- Range : 1  12
-----------------------------------------------------------------*/									
-									else if(field == 5)
-									{
-										CmdLCD(0x01);       // Clear LCD
-										CmdLCD(0x80);       // 1st line start
-										StrLCD("SET MON:");
-										
-										
-										while (1)
-										{
-											int Key=KeyVal();
-												if (Key == 15)      // Increase month
-												{
-														month++;
-														if(month==13)
-														{
-															month=1;
-														}
-												}
-												else if (Key == 16) // Decrease month
-												{
-													month--;
-													if(month < 0)
-														month=12;
-												}
-												else if (Key  == 13) // Exit edit mode
-												{
-														SetRTCDateInfo(date,month,year);
-														CmdLCD(0x01);//Clear LCD
-														goto IN;
-												}
-
-												CmdLCD(0x8A);       // 1st line
-												StrLCD("  ");       // small space
-												CmdLCD(0x8A);  
-												IntLCD(month);// Show updated minutes
-
-												delay_ms(200);     // small delay to avoid fast repeat
-										}	
-									}
-/*---------------------------------------------------------------
- Field 6 : Year Editing
-----------------------------------------------------------------*/									
-									else if(field == 6)
-									{
-										CmdLCD(0x01);       // Clear LCD
-										CmdLCD(0x80);       // 1st line start
-										StrLCD("SET YEAR:");
-										
-										
-										while (1)
-										{
-											
-											int Key=KeyVal();
-												if (Key == 15)      // Increase year
-												{
-														year++;
-												}
-												else if (Key == 16) // Decrease year
-												{
-													year--;
-												}
-												else if (Key  == 13) // Exit edit mode
-												{
-														SetRTCDateInfo(date,month,year);
-														CmdLCD(0x01);//Clear LCD
-														goto IN;
-												}
-
-												CmdLCD(0x8A);       // 1st line
-												StrLCD("  ");       // small space
-												CmdLCD(0x8A);  
-												IntLCD(year);;// Show updated minutes
-												
-												delay_ms(200);     // small delay to avoid fast repeat
-										}	
-									}
-									
-/*---------------------------------------------------------------
- Field 7 : Day of Week Editing
- Range : 0  6
-----------------------------------------------------------------*/									
-									else if(field == 7)
-									{
-										CmdLCD(0x01);       // Clear LCD
-										CmdLCD(0x80);       // 1st line start
-										StrLCD("SET DAY:");
-										
-										
-										while (1)
-										{
-											int Key=KeyVal();
-												if (Key == 15)      // Increase day
-												{
-														day++;
-														if(day==7)
-														{
-															day=0;
-														}
-												}
-												else if (Key == 16) // Decrease day
-												{
-													day--;
-													if(day < 0)
-														day=6;
-												}
-												else if (Key  == 13) // Exit edit mode
-												{
-														SetRTCDay(day);
-														CmdLCD(0x01);//Clear LCD
-														goto IN;
-												}
-
-												CmdLCD(0x88);       // 1st line
-												StrLCD("  ");       // small space
-												CmdLCD(0x8A);  
-												StrLCD((u8*)week[day]);// Show updated minutes
+/*------------------------------------------------------------
+      Edit switch as GPIO input, status LED as output
+ ------------------------------------------------------------*/
+		PINSEL2 &= ~(1<<SW);
+		IODIR1 &= ~(1<<SW);
+		IODIR1 |= (1<<LED);
+		IOCLR1 = 1<<LED;
+	
+/*------------------------------------------------------------
+      Over-temperature comparator in the ADC interrupt drives LED
+ ------------------------------------------------------------*/
+		Set_ADCAlert(CH1,setpoint*1000);
+	
+/*------------------------------------------------------------
+      RTC once-per-second interrupt
+ ------------------------------------------------------------*/
+		RTC_TickInit();
+		lastTick = GetRTCTicks()-1;// Process first tick immediately
+}
 
-												delay_ms(200);     // small delay to avoid fast repeat
-										}	
-									}
-									
-/*---------------------------------------------------------------
- Field 8 : Exit Time Editing Mode
-----------------------------------------------------------------*/
-									else if(field == 8)
-									{
-										CmdLCD(0x01);//Clear LCD
-									  goto IN1;
-									}
-								}	
-									
-/*=============================================================
-            Temperature Setpoint Editing Mode
-===============================================================
+/*--------------------------------------------------------------------
+Function: TaskSample
+Purpose : Drain sample ring, latest CH1 sample is current temperature;
+          every sample also goes to the binary log batcher
+--------------------------------------------------------------------*/
+void TaskSample(void)
+{
+		ADCSample smp;
+		
+		while(Get_ADCSample(&smp))
+		{
+				if(smp.ch == CH1)
+						currentTemp = Conv_LM35_mC_OS(smp.ch,smp.code,smp.ovs);
+				LogBatchAdd(&smp);
+		}
+		LogBatchPoll();
+}
 
- Option 2 : Temperature Setpoint Editing Mode
- Purpose :
-   - Allows user to modify temperature threshold value
-   - Setpoint is used for:
-        Over-temperature detection
-        LED alert control
-        UART alert messages
-   - Keypad controls:
-        Increment / Decrement setpoint
-        Exit to main menu
-   - LCD displays updated setpoint in real-time
-===============================================================*/
-									else if (opt == 2)  // Enter Edit Mode
-									{
-										int press1=0;
-										
-										CmdLCD(0x01);       // Clear LCD
-										CmdLCD(0x80);       // 1st line start
-										StrLCD("SET TEMP:");
-										CmdLCD(0xC0);       // 2nd line
-										CharLCD(' ');       // small space
-										DisplayTemp(setpoint); // Show updated setpoint
-										CharLCD(0xDF);     //  symbol
-										CharLCD('C');
-										
-									if(press1 == 0)
-									{
-										UARTTxStr("*** Set Point Editing Mode Activated ***\n\r");
-										press1++;
-									}
+/*--------------------------------------------------------------------
+Function: TaskAlert
+Purpose : Pick up the over-temperature state for the log records;
+          the LED itself is switched by the comparator in ADC_ISR
+          (equal to setpoint keeps the previous state)
+--------------------------------------------------------------------*/
+void TaskAlert(void)
+{
+		alertOn = Get_ADCAlert();
+}
 
-										while (1)
-										{
-												int Key = GetKeyPress();
-												if (Key == 15)      // Increase setpoint
-												{
-														setpoint++;
-												}
-												else if (Key == 16) // Decrease setpoint
-												{
-														if(setpoint > 0)
-																setpoint--;
-												}
-												else if (Key == 13) // Exit edit mode
-												{
-														CmdLCD(0x01);
-														goto IN1;
-												}
+/*--------------------------------------------------------------------
+Function: TaskLog
+Purpose : Once per RTC second tick read the clock and log:
+          alert records every second, normal records on entering
+          the normal state and every minute
+--------------------------------------------------------------------*/
+void TaskLog(void)
+{
+		u32 ts;
+		u16 tsMs;
+		
+		if(GetRTCTicks() == lastTick)
+				return;
+		lastTick = GetRTCTicks();
+		redraw = 1;
+		
+		// Read RTC values (one consistent timestamp)
+		ts = GetRTCTimestampMs(&tsMs);
+		hour = RTC_TS_HOUR(ts);
+		min = RTC_TS_MIN(ts);
+		sec = RTC_TS_SEC(ts);
+		date = RTC_TS_DATE(ts);
+		month = RTC_TS_MONTH(ts);
+		year = RTC_TS_YEAR(ts);
+		GetRTCDay(&day);
+		
+		if(alertOn)
+		{
+				normalLogged = 0;// Log again on return to normal
+				LogRecord(LOG_SEV_ALERT,CH1,currentTemp,ts,tsMs);
+		}
+		else if(!normalLogged || sec==0)
+		{
+				normalLogged = 1;
+				LogRecord(LOG_SEV_NORMAL,CH1,currentTemp,ts,tsMs);
+		}
+}
 
-												CmdLCD(0xC0);       // 2nd line
-												CharLCD(' ');       // small space
-												DisplayTemp(setpoint); // Show updated setpoint
-												CharLCD(0xDF);     //  symbol
-												CharLCD('C');
+/*--------------------------------------------------------------------
+Function: TaskDisplay
+Purpose : Display RTC & temperature on LCD after each RTC tick and
+          after leaving the edit menu
+          (LCD belongs to the edit menu while it is open)
+--------------------------------------------------------------------*/
+void TaskDisplay(void)
+{
+		if(menuState != MENU_IDLE)
+		{
+				redraw = 1;
+				return;
+		}
+		if(!redraw)
+				return;
+		redraw = 0;
+		
+		DisplayRTCTime(hour,min,sec);
+		DisplayRTCDate(date,month,year);
+		DisplayRTCDay(day);
+		
+		DisplayTemp((currentTemp<0) ? 0 : DIV1000(currentTemp));
+		FbCharLCD(0xDF);// Degree symbol
+		FbCharLCD('C');	
+		
+		// Send only changed characters to the LCD
+		FlushLCD();
+}
 
-												delay_ms(200);     // small delay to avoid fast repeat
-									  }
-								  }
-/*=============================================================
-                       Exit Edit Mode
-===============================================================
- Option 3 : Exit Edit Mode
- Purpose :
-   - Clears LCD display
-   - Returns execution to normal monitoring mode
-   - RTC display and temperature monitoring resumes
-===============================================================*/
-								  else if(opt == 3)
-								  {
-									  CmdLCD(0x01);//Clear LCD
-									  goto INPUT;
-								  }
-							  }							
-					    }
-			      }
-	       }
+/*--------------------------------------------------------------------
+Function: TaskKeypad
+Purpose : Enter edit menu on switch press edge, step edit menu
+--------------------------------------------------------------------*/
+void TaskKeypad(void)
+{
+		u8 pres = (((IOPIN1 >> SW)&1)==0);
 		
+		if(pres && !prevpres && (menuState == MENU_IDLE))
+				MenuShowMain();
+		prevpres = pres;
+		
+		MenuStep();
+}
+
+/*--------------------------------------------------------------------
+Function: TaskCmd
+Purpose : UART commands (SET SP/TIME/DATE/MODE, GET STATS, DUMP)
+--------------------------------------------------------------------*/
+void TaskCmd(void)
+{
+		CmdPoll();
 }
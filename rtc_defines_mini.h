@@ -15,6 +15,50 @@
 #define RTC_RESET   (1<<1)
 #define RTC_CLKSRC  (1<<4)
 
+//CTIME0 consolidated time register fields
+#define CT0_SEC(ct)   ((ct)&0x3F)
+#define CT0_MIN(ct)   (((ct)>>8)&0x3F)
+#define CT0_HOUR(ct)  (((ct)>>16)&0x1F)
+#define CT0_DOW(ct)   (((ct)>>24)&0x07)
+
+//CTIME1 consolidated date register fields
+#define CT1_DOM(ct)   ((ct)&0x1F)
+#define CT1_MONTH(ct) (((ct)>>8)&0x0F)
+#define CT1_YEAR(ct)  (((ct)>>16)&0xFFF)
+
+//Packed 32-bit timestamp, ordered so that later times compare greater
+//bits : 31-26 year-RTC_TS_YEAR_BASE, 25-22 month, 21-17 date,
+//       16-12 hour, 11-6 minute, 5-0 second
+//Years outside RTC_TS_YEAR_MIN-MAX do not fit the 6-bit year field;
+//every RTC date writer (SetRTCDateInfo) limits the year to this range
+#define RTC_TS_YEAR_BASE 2000
+#define RTC_TS_YEAR_MIN  RTC_TS_YEAR_BASE
+#define RTC_TS_YEAR_MAX  (RTC_TS_YEAR_BASE+63)
+#define RTC_TS_PACK(y,mo,d,h,mi,s) ((((u32)(y)-RTC_TS_YEAR_BASE)<<26)|((u32)(mo)<<22)|\
+                                    ((u32)(d)<<17)|((u32)(h)<<12)|((u32)(mi)<<6)|(u32)(s))
+#define RTC_TS_SEC(ts)   ((ts)&0x3F)
+#define RTC_TS_MIN(ts)   (((ts)>>6)&0x3F)
+#define RTC_TS_HOUR(ts)  (((ts)>>12)&0x1F)
+#define RTC_TS_DATE(ts)  (((ts)>>17)&0x1F)
+#define RTC_TS_MONTH(ts) (((ts)>>22)&0x0F)
+#define RTC_TS_YEAR(ts)  ((((ts)>>26)&0x3F)+RTC_TS_YEAR_BASE)
+
+//CTC clock tick counter : bits 15-1 count 32768 ticks per second and
+//restart on every seconds increment, giving the sub-second position
+#define CTC_TICKS(ctc)   (((ctc)>>1)&0x7FFF)
+#define CTC_TO_MS(t)     ((((u32)(t))*1000UL)>>15)
+
+//ILR interrupt location register bits (write 1 to clear)
+#define RTCCIF_BIT 0
+#define RTCALF_BIT 1
+
+//CIIR counter increment interrupt register bits
+#define IMSEC_BIT 0
+#define IMMIN_BIT 1
+
+//VIC channel used for RTC
+#define RTC_VIC_CHNO 13
+
 //#define _LPC2148
 
 
@@ -16,4 +16,11 @@ void GetRTCDay(s32 *);
 void DisplayRTCDay(u32);
 void SetRTCDay(u32);
 
+u32 GetRTCTimestamp(void);
+u32 GetRTCTimestampMs(u16 *);
+u32 RTCTsToEpoch(u32);
+
+void RTC_TickInit(void);
+u32 GetRTCTicks(void);
+
 #endif
@@ -0,0 +1,197 @@
+/*===============================================================
+File: sched.c
+Purpose: Cooperative run-to-completion task scheduler.
+Tasks are registered in a static table with a period and a
+deadline in scheduler ticks (SCHED_TICK_US, Timer1 MR1). The
+loop in SchedStart() runs every released task to completion in
+table order, then idles the CPU until the next interrupt.
+Per task the scheduler counts runs, deadline misses and the
+worst-case execution time measured on the s timebase.
+- period 0 : task runs on every pass (event polling)
+- deadline : ticks after release by which the task must finish
+===============================================================*/
+
+// Header with LPC21xx register definitions
+#include<LPC21xx.h>
+
+// Header containing project-specific macros, typedefs & prototypes
+#include "Mini_headers.h"
+
+#if SCHED_LINE_MAX > UART_TX_BUF_SIZE-1
+#error "SchedReport line does not fit the UART transmit ring"
+#endif
+
+//---------------------------------------------------------
+// Task table
+//---------------------------------------------------------
+typedef struct
+{
+		s8 *name;								// Shown by SchedReport
+		void (*run)(void);				// Task body, must not block
+		u32 period;							// Release interval in ticks (0 = every pass)
+		u32 deadline;						// Allowed completion time after release
+		u32 next;								// Tick of next release
+		u32 runs;								// Completed runs
+		u32 misses;							// Runs finished after their deadline
+		u32 wcet;								// Longest run time in s
+}SchedTask;
+
+SchedTask schedTasks[SCHED_MAX_TASKS];
+u32 schedNTasks=0;
+volatile u32 schedTicks=0;// Incremented by SchedTick every SCHED_TICK_US
+
+//------------------------------------------------------------
+// Function: SchedAdd
+// Purpose : Register a task before SchedStart
+// Arguments:
+// name     - Task name
+// run      - Task function
+// period   - Release interval in ticks, 0 = run on every pass
+// deadline - Ticks after release by which run must complete
+// Return   : Task index, or SCHED_MAX_TASKS if the table is full
+//            or name is longer than SCHED_NAME_MAX
+//------------------------------------------------------------
+
+u32 SchedAdd(s8 *name,void (*run)(void),u32 period,u32 deadline)
+{
+			SchedTask *t;
+			u32 len=0;
+	
+			while(name[len])
+				len++;
+			if(schedNTasks>=SCHED_MAX_TASKS || len>SCHED_NAME_MAX)
+				return SCHED_MAX_TASKS;
+	
+			t=&schedTasks[schedNTasks];
+			t->name=name;
+			t->run=run;
+			t->period=period;
+			t->deadline=deadline;
+			t->next=schedTicks;
+			t->runs=0;
+			t->misses=0;
+			t->wcet=0;
+			return schedNTasks++;
+}
+
+//------------------------------------------------------------
+// Function: SchedTick
+// Purpose : Scheduler tick, called from Timer1_ISR on MR1 match
+//------------------------------------------------------------
+
+void SchedTick(void)
+{
+			T1MR1+=SCHED_TICK_US;
+			schedTicks++;
+}
+
+//------------------------------------------------------------
+// Function: SchedTicks
+// Purpose : Return ticks since SchedStart
+//------------------------------------------------------------
+
+u32 SchedTicks(void)
+{
+			return schedTicks;
+}
+
+//------------------------------------------------------------
+// Function: SchedRun
+// Purpose : Run one task and update its statistics
+//------------------------------------------------------------
+
+static void SchedRun(SchedTask *t,u32 now)
+{
+			u32 t0,dt;
+	
+			t0=Micros();
+			t->run();
+			dt=Micros()-t0;
+	
+			if(dt>t->wcet)
+				t->wcet=dt;
+			t->runs++;
+	
+			if(t->period)
+			{
+				// Late if still running past release + deadline
+				if((s32)(schedTicks-(t->next+t->deadline))>0)
+					t->misses++;
+	
+				// Next release; skip releases already missed
+				t->next+=t->period;
+				if((s32)(now-t->next)>=0)
+					t->next=now+t->period;
+			}
+}
+
+//------------------------------------------------------------
+// Function: SchedStart
+// Purpose : Start the tick and run the task table forever
+// Note    : Never returns
+//------------------------------------------------------------
+
+void SchedStart(void)
+{
+			u32 i,now,due;
+			SchedTask *t;
+	
+			// MR1 tick on the free running s timebase
+			Timebase_Init();
+			T1MR1=T1TC+SCHED_TICK_US;
+			T1MCR|=1<<MR1I_BIT;
+	
+			for(i=0;i<schedNTasks;i++)
+				schedTasks[i].next=schedTicks;
+	
+			while(1)
+			{
+				now=schedTicks;
+				for(i=0;i<schedNTasks;i++)
+				{
+					t=&schedTasks[i];
+					if(!t->period || (s32)(now-t->next)>=0)
+						SchedRun(t,now);
+				}
+	
+				// Idle unless a periodic task became due meanwhile
+				now=schedTicks;
+				due=0;
+				for(i=0;i<schedNTasks;i++)
+				{
+					t=&schedTasks[i];
+					if(t->period && (s32)(now-t->next)>=0)
+						due=1;
+				}
+				if(!due)
+					PCON=1<<PCON_IDL_BIT;
+			}
+}
+
+//------------------------------------------------------------
+// Function: SchedReport
+// Purpose : Send one line per task: runs, misses, WCET (s)
+// Note    : Waits for ring space before each line, so the report
+//           blocks the caller instead of dropping bytes
+//------------------------------------------------------------
+
+void SchedReport(void)
+{
+			u32 i;
+			SchedTask *t;
+	
+			for(i=0;i<schedNTasks;i++)
+			{
+				t=&schedTasks[i];
+				UARTTxWait(SCHED_LINE_MAX);
+				UARTTxStr("TASK ");
+				UARTTxStr(t->name);
+				UARTTxStr(" runs=");
+				UARTTxU32(t->runs);
+				UARTTxStr(" miss=");
+				UARTTxU32(t->misses);
+				UARTTxStr(" wcet=");
+				UARTTxU32(t->wcet);
+				UARTTxStr("us\n\r");
+			}
+}
@@ -0,0 +1,13 @@
+//sched.h
+#ifndef SCHED_H
+#define SCHED_H
+
+#include "types.h"
+
+u32 SchedAdd(s8 *name,void (*run)(void),u32 period,u32 deadline);
+void SchedStart(void);
+void SchedTick(void);
+u32 SchedTicks(void);
+void SchedReport(void);
+
+#endif
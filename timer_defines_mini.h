@@ -0,0 +1,21 @@
+#ifndef TIMER_DEFINES_H
+#define TIMER_DEFINES_H
+
+//defines for TxTCR sfr
+#define TCR_EN_BIT    0
+#define TCR_RESET_BIT 1
+
+//defines for TxMCR sfr
+#define MR0I_BIT      0	//interrupt on MR0 match
+#define MR0R_BIT      1	//reset TC on MR0 match
+#define MR1I_BIT      3	//interrupt on MR1 match
+
+//defines for TxIR sfr
+#define MR0_INT_BIT   0
+#define MR1_INT_BIT   1
+
+//VIC channels of the timers
+#define TIMER0_VIC_CHNO 4
+#define TIMER1_VIC_CHNO 5
+
+#endif
@@ -4,6 +4,7 @@ typedef unsigned short int u16;
 typedef signed short int s16;
 typedef unsigned long int u32;
 typedef signed long int s32;
+typedef unsigned long long u64;
 typedef float f32;
 typedef double f64;
 
@@ -6,7 +6,15 @@ Provides UART transmit and receive functions for:
 - Single character
 - 32-bit unsigned integer
 - 32-bit floating point (ve supported)
+- Fixed point millis value (integer only, ve supported)
 - String transmit
+Transmit is non-blocking: characters are queued in a RAM ring
+buffer which the THRE interrupt drains into the 16-byte FIFO.
+UARTTxSpan() queues a whole formatted record in one call.
+UARTTxWait() blocks until the ring has room for a line, for
+multi-line reports that would otherwise overrun the ring.
+Receive is interrupt driven too: RDA/CTI interrupts move received
+bytes into a ring buffer read without blocking by UARTRxGet().
 ------------------------------------------------------------*/
 
 // Header with LPC21xx register definitions
@@ -15,11 +23,35 @@ Provides UART transmit and receive functions for:
 // Header containing project-specific macros, typedefs and prototypes
 #include "Mini_headers.h"
 
+//---------------------------------------------------------
+// Transmit ring buffer shared between main loop and UART0 ISR
+// uartTxHead : written only by producer (UARTTxChar)
+// uartTxTail : written only by consumer (UART0_ISR / kick)
+//---------------------------------------------------------
+
+volatile u8  uartTxBuf[UART_TX_BUF_SIZE];
+volatile u32 uartTxHead=0,uartTxTail=0;
+volatile u32 uartTxBusy=0;	// 1 -> FIFO is being drained by THRE interrupts
+volatile u32 uartTxOvfCnt=0;	// Bytes dropped because ring was full
+
+//---------------------------------------------------------
+// Receive ring buffer shared between UART0 ISR and main loop
+// uartRxHead : written only by producer (UART0_ISR)
+// uartRxTail : written only by consumer (UARTRxGet)
+//---------------------------------------------------------
+
+volatile u8  uartRxBuf[UART_RX_BUF_SIZE];
+volatile u32 uartRxHead=0,uartRxTail=0;
+volatile u32 uartRxOvfCnt=0;	// Bytes dropped because ring was full
+
+void UART0_ISR(void) __irq;
+
 //------------------------------------------------------------
 // Function: InitUART
 // Purpose : Configure UART0 peripheral function & baud settings
 // Pins    : P0.0 = TXD0, P0.1 = RXD0 (FUNC1)
-// Baud    : Configured using U0DLL and U0DLM with 8-bit data mode
+// Baud    : UART_BAUD, divisor UART_DIVISOR computed from PCLK
+//           (uart_defines_mini.h) loaded into U0DLM:U0DLL
 //------------------------------------------------------------
 
 void InitUART(void)
@@ -37,38 +69,250 @@ void InitUART(void)
 			U0LCR|=1<<7;
 	
 			// Set baud rate divisor values
-			U0DLL=97;
-			U0DLM=0;
+			U0DLL=UART_DIVISOR&0xFF;
+			U0DLM=UART_DIVISOR>>8;
 	
 			// Disable DLAB after configuration
 			U0LCR&=~(1<<7);
+	
+			// Enable and reset RX/TX FIFOs (16 bytes each), RX interrupt at 8 bytes
+			U0FCR=(1<<FIFO_EN_BIT)|(1<<RX_FIFO_RST_BIT)|(1<<TX_FIFO_RST_BIT)|
+			      (RX_TRIG_8<<RX_TRIG_BITS);
+	
+			// Install UART0 ISR in its VIC vectored slot
+			VicInstall(VIC_SLOT_UART0,UART0_VIC_CHNO,(u32)UART0_ISR,"UART0");
+	
+			// Enable THRE interrupt used to drain the transmit ring and
+			// RBR interrupt (RDA + CTI) used to fill the receive ring
+			U0IER=(1<<THRE_INT_EN_BIT)|(1<<RBR_INT_EN_BIT);
+}
+
+//------------------------------------------------------------
+// Function: UARTTxFill
+// Purpose : Move up to one FIFO worth of bytes from the ring
+//           buffer into U0THR. Clears uartTxBusy when ring is
+//           empty so the next UARTTxChar() restarts transmission.
+// Note    : Called from UART0_ISR or with UART0 VIC channel masked
+//------------------------------------------------------------
+
+static void UARTTxFill(void)
+{
+	u32 n=UART0_TX_FIFO_LEN;
+	
+	if(uartTxTail==uartTxHead)
+	{
+		uartTxBusy=0;
+		return;
+	}
+	while(n-- && (uartTxTail!=uartTxHead))
+	{
+		U0THR=uartTxBuf[uartTxTail];
+		uartTxTail=(uartTxTail+1)&UART_TX_BUF_MASK;
+	}
+	uartTxBusy=1;
+}
+
+//------------------------------------------------------------
+// Function: UARTRxDrain
+// Purpose : Move every byte in the RX FIFO into the receive ring.
+//           Bytes are dropped and counted when the ring is full.
+// Note    : Called from UART0_ISR only
+//------------------------------------------------------------
+
+static void UARTRxDrain(void)
+{
+	u32 next;
+	u8 ch;
+	
+	while(READBIT(U0LSR,RDR_BIT))
+	{
+		ch=U0RBR;
+		next=(uartRxHead+1)&UART_RX_BUF_MASK;
+		if(next==uartRxTail)
+			uartRxOvfCnt++;
+		else
+		{
+			uartRxBuf[uartRxHead]=ch;
+			uartRxHead=next;
+		}
+	}
+}
+
+//------------------------------------------------------------
+// Function: UART0_ISR
+// Purpose : UART0 interrupt handler, refills the TX FIFO on THRE
+//           and empties the RX FIFO on RDA / CTI
+//------------------------------------------------------------
+
+void UART0_ISR(void) __irq
+{
+	u32 iir,t0=VicIsrEnter();
+	
+	// Reading U0IIR clears the THRE interrupt source
+	while(READBIT((iir=U0IIR),IIR_PEND_BIT)==0)
+	{
+		switch(iir&IIR_ID_MASK)
+		{
+			case IIR_RLS:
+				// Reading U0LSR clears line status (overrun/framing)
+				iir=U0LSR;
+				UARTRxDrain();
+				break;
+			case IIR_RDA:
+			case IIR_CTI:
+				UARTRxDrain();
+				break;
+			default:
+				UARTTxFill();
+				break;
+		}
+	}
+	
+	VicIsrExit(VIC_SLOT_UART0,t0);
+	
+	// Acknowledge interrupt to VIC
+	VICVectAddr=0;
+}
+
+//------------------------------------------------------------
+// Function: UARTRxGet
+// Purpose : Take one received character from the receive ring
+// Argument: ch - Pointer to store character
+// Return  : 1 if a character was read, 0 if ring is empty
+//------------------------------------------------------------
+
+u32 UARTRxGet(u8 *ch)
+{
+		if(uartRxTail==uartRxHead)
+			return 0;
+		*ch=uartRxBuf[uartRxTail];
+		uartRxTail=(uartRxTail+1)&UART_RX_BUF_MASK;
+		return 1;
 }
 
 //------------------------------------------------------------
 // Function: UARTRxChar
 // Purpose : Receive a single character from UART0
-// Logic   : Wait until RDR (Receiver Data Ready) bit is set
-// Return  : 8-bit received character from U0RBR register
+// Logic   : Wait until the receive ring holds a character
+// Return  : 8-bit received character
 //------------------------------------------------------------
 
 s8 UARTRxChar(void)
 {
-		while(!READBIT(U0LSR,0));
-		return (U0RBR);
+		u8 ch;
+		while(!UARTRxGet(&ch));
+		return (ch);
 
 }
 
 //------------------------------------------------------------
 // Function: UARTTxChar
-// Purpose : Transmit a single character via UART0
-// Logic   : Load U0THR and wait until THRE (Transmit Holding
-//           Register Empty) bit confirms transmission
+// Purpose : Queue a single character for transmit via UART0
+// Logic   : Append to ring buffer and return immediately. If the
+//           transmitter is idle, prime the FIFO directly; otherwise
+//           the THRE interrupt picks the byte up. When the ring is
+//           full the byte is dropped and uartTxOvfCnt incremented.
 //------------------------------------------------------------
 
 void UARTTxChar(s8 ch)
 {
-	U0THR=ch;
-	while(!READBIT(U0LSR,6));
+	u32 next=(uartTxHead+1)&UART_TX_BUF_MASK,irq;
+	
+	if(next==uartTxTail)
+	{
+		uartTxOvfCnt++;
+		return;
+	}
+	uartTxBuf[uartTxHead]=ch;
+	uartTxHead=next;
+	
+	// Mask UART0 in VIC while checking/priming the idle transmitter
+	irq=VicMask(1<<UART0_VIC_CHNO);
+	if(!uartTxBusy)
+		UARTTxFill();
+	VicRestore(irq);
+}
+
+//------------------------------------------------------------
+// Function: UARTTxSpan
+// Purpose : Queue a block of bytes for transmit via UART0
+// Logic   : Copy the whole block into the ring and prime the
+//           transmitter once. If the ring cannot take all len
+//           bytes nothing is queued, so records are never split;
+//           the bytes are counted in uartTxOvfCnt.
+// Arguments: buf - Bytes to send, len - Number of bytes
+// Return  : 1 if queued, 0 if dropped
+//------------------------------------------------------------
+
+u32 UARTTxSpan(u8 *buf,u32 len)
+{
+	u32 head=uartTxHead,irq;
+	
+	if(((uartTxTail-head-1)&UART_TX_BUF_MASK) < len)
+	{
+		uartTxOvfCnt+=len;
+		return 0;
+	}
+	while(len--)
+	{
+		uartTxBuf[head]=*buf++;
+		head=(head+1)&UART_TX_BUF_MASK;
+	}
+	uartTxHead=head;
+	
+	// Mask UART0 in VIC while checking/priming the idle transmitter
+	irq=VicMask(1<<UART0_VIC_CHNO);
+	if(!uartTxBusy)
+		UARTTxFill();
+	VicRestore(irq);
+	return 1;
+}
+
+//------------------------------------------------------------
+// Function: UARTTxWait
+// Purpose : Block until the ring has room for len more bytes, so
+//           a line of up to len bytes is queued without drops
+// Note    : Task level only (the THRE interrupt must drain the
+//           ring); len is limited to the ring capacity
+//------------------------------------------------------------
+
+void UARTTxWait(u32 len)
+{
+	if(len>UART_TX_BUF_SIZE-1)
+		len=UART_TX_BUF_SIZE-1;
+	while(((uartTxTail-uartTxHead-1)&UART_TX_BUF_MASK) < len);
+}
+
+//------------------------------------------------------------
+// Function: UARTTxFlush
+// Purpose : Block until every queued byte has left the shift
+//           register (ring empty and TEMT set)
+//------------------------------------------------------------
+
+void UARTTxFlush(void)
+{
+	while(uartTxBusy || (uartTxTail!=uartTxHead));
+	while(!READBIT(U0LSR,TEMT_BIT));
+}
+
+//------------------------------------------------------------
+// Function: UARTTxOvfCount
+// Purpose : Return number of bytes dropped due to a full ring
+//------------------------------------------------------------
+
+u32 UARTTxOvfCount(void)
+{
+	return uartTxOvfCnt;
+}
+
+//------------------------------------------------------------
+// Function: UARTRxOvfCount
+// Purpose : Return number of received bytes dropped due to a full ring
+//------------------------------------------------------------
+
+u32 UARTRxOvfCount(void)
+{
+	return uartRxOvfCnt;
 }
 
 //------------------------------------------------------------
@@ -87,27 +331,16 @@ void UARTTxStr(s8 *ptr)
 //------------------------------------------------------------
 // Function: UARTTxU32
 // Purpose : Convert and transmit a 32-bit unsigned integer
-// Method  : Manual integer-to-ASCII conversion (itoa logic)
+// Method  : FmtU32 (two digits per step, no division)
 // Argument: num ? 32-bit unsigned integer
 //------------------------------------------------------------
 
 void UARTTxU32(u32 num)
 {	
-	u8 a[10];
-	s8 i=0;
-	//itoa
-	if(num==0)
-		UARTTxChar('0');
-	else
-	{
-		while(num>0)
-		{
-			a[i++]=num%10+48;
-			num=num/10;
-		}
-		for(--i;i>=0;i--)
-			UARTTxChar(a[i]);
-	}	
+	u8 a[11];
+	
+	FmtU32(a,num,1);
+	UARTTxStr((s8*)a);
 }
 
 //------------------------------------------------------------
@@ -138,5 +371,25 @@ void UARTTxF32(f32 fnum)
 	}
 }
 
+//------------------------------------------------------------
+// Function: UARTTxMilli
+// Purpose : Transmit a value held in thousandths (e.g. mC) as
+//           fixed point with 3 decimal places, integer math only
+// Argument: num ? signed value in thousandths
+//------------------------------------------------------------
 
-
+void UARTTxMilli(s32 num)
+{
+	u8 a[11];
+	u32 whole;
+	if(num<0)
+	{
+		UARTTxChar('-');
+		num=-num;
+	}
+	whole=DIV1000(num);
+	UARTTxU32(whole);
+	UARTTxChar('.');
+	FmtU32(a,num-whole*1000,3);
+	UARTTxStr((s8*)a);
+}
@@ -0,0 +1,57 @@
+#ifndef UART_DEFINES_H
+#define UART_DEFINES_H
+
+//defines for U0LSR sfr
+#define RDR_BIT  0
+#define THRE_BIT 5
+#define TEMT_BIT 6
+
+//defines for U0IER sfr
+#define RBR_INT_EN_BIT  0
+#define THRE_INT_EN_BIT 1
+
+//defines for U0IIR sfr
+#define IIR_PEND_BIT 0	//0 -> interrupt pending
+#define IIR_ID_MASK  0x0E
+#define IIR_THRE     0x02
+#define IIR_RLS      0x06	//Receive line status
+#define IIR_RDA      0x04	//Receive data available (trigger level)
+#define IIR_CTI      0x0C	//Character time-out, data below trigger level
+
+//defines for U0FCR sfr
+#define FIFO_EN_BIT     0
+#define RX_FIFO_RST_BIT 1
+#define TX_FIFO_RST_BIT 2
+#define RX_TRIG_BITS    6	//RX trigger level 0:1, 1:4, 2:8, 3:14 chars
+#define RX_TRIG_8       2
+
+//Baud rate; the divisor is derived from PCLK at compile time
+//(UART0 of the LPC2129 has no fractional divider, only DLM:DLL)
+#define UART_BAUD         115200
+#define UART_BAUD_MAX_ERR 20	//Max baud rate error in 0.1 % units
+#define UART_DIVISOR      ((PCLK+8UL*UART_BAUD)/(16UL*UART_BAUD))
+#define UART_BAUD_ACTUAL  (PCLK/(16UL*UART_DIVISOR))
+
+#if (UART_DIVISOR < 1) || (UART_DIVISOR > 0xFFFF)
+#error "UART_BAUD not reachable from PCLK"
+#endif
+#if (UART_BAUD_ACTUAL*1000 > UART_BAUD*(1000UL+UART_BAUD_MAX_ERR)) || \
+    (UART_BAUD_ACTUAL*1000 < UART_BAUD*(1000UL-UART_BAUD_MAX_ERR))
+#error "UART_BAUD error exceeds UART_BAUD_MAX_ERR at this PCLK"
+#endif
+
+//UART0 hardware transmit FIFO depth
+#define UART0_TX_FIFO_LEN 16
+
+//Transmit ring buffer size (must be a power of 2)
+#define UART_TX_BUF_SIZE 256
+#define UART_TX_BUF_MASK (UART_TX_BUF_SIZE-1)
+
+//Receive ring buffer size (must be a power of 2)
+#define UART_RX_BUF_SIZE 64
+#define UART_RX_BUF_MASK (UART_RX_BUF_SIZE-1)
+
+//VIC channel used for UART0
+#define UART0_VIC_CHNO 6
+
+#endif
@@ -3,5 +3,12 @@ void InitUART(void);
 void UARTTxChar(s8);
 void UARTTxStr(s8 *);
 s8 UARTRxChar(void);
+u32 UARTRxGet(u8 *);
+u32 UARTRxOvfCount(void);
 void UARTTxU32(u32);
 void UARTTxF32(f32);
+void UARTTxMilli(s32);
+void UARTTxFlush(void);
+void UARTTxWait(u32);
+u32 UARTTxSpan(u8 *,u32);
+u32 UARTTxOvfCount(void);
@@ -0,0 +1,222 @@
+/*===============================================================
+File: vic.c
+Functions: VicInit, VicInstall, VicMask, VicRestore, VicIsrEnter,
+           VicIsrExit, VicLatency, VicCount, VicMaxUs, VicMaxLatUs,
+           VicReport.
+Purpose:
+   - Single owner of the LPC21xx Vectored Interrupt Controller:
+     every driver installs its ISR here in the slot assigned in
+     vic_defines_mini.h (slot number = priority)
+   - VicMask()/VicRestore() critical sections for ring buffers
+     and state shared between an ISR and task level code
+   - Per slot invocation count, longest service time and, for
+     sources with a hardware reference (timer matches), longest
+     entry latency; all in s on the Timer1 timebase
+Note: ISRs bracket their body with VicIsrEnter()/VicIsrExit()
+      and still acknowledge the VIC themselves (VICVectAddr=0).
+===============================================================*/
+
+// Header with LPC21xx register definitions
+#include<LPC21xx.h>
+
+// Header containing project-specific macros, typedefs & prototypes
+#include "Mini_headers.h"
+
+#if VIC_LINE_MAX > UART_TX_BUF_SIZE-1
+#error "VicReport line does not fit the UART transmit ring"
+#endif
+
+//---------------------------------------------------------
+// Per slot statistics, written only by the slot's ISR
+//---------------------------------------------------------
+typedef struct
+{
+		s8 *name;							// Shown by VicReport
+		u32 chNo;							// VIC channel in this slot
+		volatile u32 count;		// ISR invocations
+		volatile u32 maxUs;		// Longest ISR body in s
+		volatile u32 maxLat;	// Longest request-to-entry latency in s
+}VicSlot;
+
+VicSlot vicSlots[VIC_SLOTS];
+u32 vicInstalled=0;// Channels with a vectored slot
+volatile u32 vicSpurious=0;// Non-vectored (default) interrupts
+
+void Vic_DefISR(void) __irq;
+
+//------------------------------------------------------------
+// Function: VicInit
+// Purpose : All channels disabled and IRQ (not FIQ), default
+//           vector counts unexpected interrupts
+// Note    : Call before any driver installs an ISR
+//------------------------------------------------------------
+
+void VicInit(void)
+{
+			VICIntEnClr=VIC_ALL_MASK;
+			VICIntSelect=0;
+			vicInstalled=0;
+			VICDefVectAddr=(u32)Vic_DefISR;
+}
+
+//------------------------------------------------------------
+// Function: VicInstall
+// Purpose : Install ISR in a vectored slot as IRQ and enable it
+// Arguments:
+// slot - Vectored slot (VIC_SLOT_x, lower is higher priority)
+// chNo - VIC channel of the peripheral
+// isr  - Address of the __irq handler
+// name - Shown by VicReport, at most VIC_NAME_MAX characters
+//------------------------------------------------------------
+
+void VicInstall(u32 slot,u32 chNo,u32 isr,s8 *name)
+{
+			VicSlot *s=&vicSlots[slot];
+
+			s->name=name;
+			s->chNo=chNo;
+			s->count=0;
+			s->maxUs=0;
+			s->maxLat=0;
+
+			// VICVectAddr0-15 and VICVectCntl0-15 are consecutive words
+			vicInstalled|=1<<chNo;
+			VICIntSelect&=~(1<<chNo);
+			(&VICVectAddr0)[slot]=isr;
+			(&VICVectCntl0)[slot]=(1<<VIC_SLOT_EN_BIT)|chNo;
+			VICIntEnable=1<<chNo;
+}
+
+//------------------------------------------------------------
+// Function: VicMask
+// Purpose : Enter a critical section by masking VIC channels
+// Arguments: chMask - Channels to mask (1<<x_VIC_CHNO, or
+//            VIC_ALL_MASK for every interrupt)
+// Return  : Channels that were enabled, for VicRestore; sections
+//           nest because only those are re-enabled
+//------------------------------------------------------------
+
+u32 VicMask(u32 chMask)
+{
+			u32 saved=VICIntEnable&chMask;
+
+			VICIntEnClr=chMask;
+			return saved;
+}
+
+//------------------------------------------------------------
+// Function: VicRestore
+// Purpose : Leave a critical section entered with VicMask
+//------------------------------------------------------------
+
+void VicRestore(u32 saved)
+{
+			VICIntEnable=saved;
+}
+
+//------------------------------------------------------------
+// Function: VicIsrEnter
+// Purpose : Timestamp at ISR entry, passed on to VicIsrExit
+//------------------------------------------------------------
+
+u32 VicIsrEnter(void)
+{
+			return Micros();
+}
+
+//------------------------------------------------------------
+// Function: VicIsrExit
+// Purpose : Count one invocation of slot and its service time
+//------------------------------------------------------------
+
+void VicIsrExit(u32 slot,u32 t0)
+{
+			VicSlot *s=&vicSlots[slot];
+			u32 dt=Micros()-t0;
+
+			s->count++;
+			if(dt>s->maxUs)
+				s->maxUs=dt;
+}
+
+//------------------------------------------------------------
+// Function: VicLatency
+// Purpose : Record entry latency measured by the ISR itself
+//           (time from its timer match to ISR entry)
+//------------------------------------------------------------
+
+void VicLatency(u32 slot,u32 us)
+{
+			if(us>vicSlots[slot].maxLat)
+				vicSlots[slot].maxLat=us;
+}
+
+//------------------------------------------------------------
+// Function: VicCount / VicMaxUs / VicMaxLatUs
+// Purpose : Runtime read of the per slot counters
+//------------------------------------------------------------
+
+u32 VicCount(u32 slot)
+{
+			return vicSlots[slot].count;
+}
+
+u32 VicMaxUs(u32 slot)
+{
+			return vicSlots[slot].maxUs;
+}
+
+u32 VicMaxLatUs(u32 slot)
+{
+			return vicSlots[slot].maxLat;
+}
+
+//------------------------------------------------------------
+// Function: VicReport
+// Purpose : Send one line per installed slot over UART
+// Note    : Up to VIC_SLOTS+1 lines of VIC_LINE_MAX bytes (5 slots
+//           used: ~300 bytes), more than the transmit ring holds,
+//           so each line first waits for ring space
+//------------------------------------------------------------
+
+void VicReport(void)
+{
+			u32 i;
+			VicSlot *s;
+
+			for(i=0;i<VIC_SLOTS;i++)
+			{
+				s=&vicSlots[i];
+				if(!s->name)
+					continue;
+				UARTTxWait(VIC_LINE_MAX);
+				UARTTxStr("IRQ ");
+				UARTTxStr(s->name);
+				UARTTxStr(" slot=");
+				UARTTxU32(i);
+				UARTTxStr(" n=");
+				UARTTxU32(s->count);
+				UARTTxStr(" max=");
+				UARTTxU32(s->maxUs);
+				UARTTxStr("us lat=");
+				UARTTxU32(s->maxLat);
+				UARTTxStr("us\n\r");
+			}
+			UARTTxWait(VIC_LINE_MAX);
+			UARTTxStr("IRQ spurious=");
+			UARTTxU32(vicSpurious);
+			UARTTxStr("\n\r");
+}
+
+//------------------------------------------------------------
+// Function: Vic_DefISR
+// Purpose : Default vector, taken by an enabled channel that
+//           has no vectored slot; the channel is disabled
+//------------------------------------------------------------
+
+void Vic_DefISR(void) __irq
+{
+			vicSpurious++;
+			VICIntEnClr=VICIRQStatus&~vicInstalled;
+			VICVectAddr=0;
+}
@@ -0,0 +1,24 @@
+#ifndef VIC_DEFINES_H
+#define VIC_DEFINES_H
+
+//Vectored IRQ slots, lower slot = higher priority
+//(channel numbers are in each driver's define header)
+#define VIC_SLOT_TIMER0 0	//ADC sample pacing
+#define VIC_SLOT_ADC    1	//ADC conversion done
+#define VIC_SLOT_UART0  2	//UART0 TX refill / RX drain
+#define VIC_SLOT_TIMER1 3	//Scheduler tick, keypad scan
+#define VIC_SLOT_RTC    4	//RTC seconds tick
+#define VIC_SLOTS       16
+
+//defines for VICVectCntlx sfr
+#define VIC_SLOT_EN_BIT 5
+
+//VicReport line "IRQ <name> slot=<nn> n=<u32> max=<u32>us lat=<u32>us\n\r"
+//(the closing "IRQ spurious=<u32>" line is shorter)
+#define VIC_NAME_MAX    8	//Longest name given to VicInstall
+#define VIC_LINE_MAX    (4+VIC_NAME_MAX+6+2+3+10+5+10+7+10+4)	//69 bytes
+
+//All VIC channels, for VicMask()
+#define VIC_ALL_MASK    0xFFFFFFFF
+
+#endif
@@ -0,0 +1,19 @@
+//vic.h
+#ifndef VIC_H
+#define VIC_H
+
+#include "types.h"
+
+void VicInit(void);
+void VicInstall(u32 slot,u32 chNo,u32 isr,s8 *name);
+u32 VicMask(u32 chMask);
+void VicRestore(u32 saved);
+u32 VicIsrEnter(void);
+void VicIsrExit(u32 slot,u32 t0);
+void VicLatency(u32 slot,u32 us);
+u32 VicCount(u32 slot);
+u32 VicMaxUs(u32 slot);
+u32 VicMaxLatUs(u32 slot);
+void VicReport(void);
+
+#endif